@@ -0,0 +1,74 @@
+#include "feedback.h"
+#include "feedback_batch.h"
+#include "wordle_solver.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double nanoseconds_per_pattern(const Clock::time_point start,
+                               const Clock::time_point end,
+                               const std::size_t pattern_count) {
+  return static_cast<double>(
+             std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+                 .count()) /
+         static_cast<double>(pattern_count);
+}
+
+} // namespace
+
+int main() {
+  const auto words = WordleSolver::load_wordlist("word_lists/all_words.txt");
+  const auto solutions =
+      WordleSolver::load_wordlist("word_lists/all_solutions.txt");
+  const auto pattern_count = words.size() * solutions.size();
+
+  std::vector<Feedback::Pattern> expected(pattern_count);
+  std::vector<Feedback::Pattern> actual(pattern_count);
+
+  auto start = Clock::now();
+  for (std::size_t g = 0; g < words.size(); ++g) {
+    for (std::size_t s = 0; s < solutions.size(); ++s) {
+      expected[g * solutions.size() + s] =
+          Feedback::pattern(words[g], solutions[s]);
+    }
+  }
+  auto end = Clock::now();
+  const auto baseline = nanoseconds_per_pattern(start, end, pattern_count);
+
+  std::cout << words.size() << " guesses x " << solutions.size()
+            << " solutions\n\n";
+  std::cout << "Feedback::pattern      " << baseline << " ns/pattern\n";
+
+  const WordList packed_words{words};
+  const SolutionBlock block{WordList{solutions}};
+  bool all_match{true};
+
+  for (const auto isa :
+       {FeedbackBatch::Isa::scalar, FeedbackBatch::Isa::sse42,
+        FeedbackBatch::Isa::avx2}) {
+    if (isa > FeedbackBatch::best_isa()) {
+      continue;
+    }
+    start = Clock::now();
+    for (std::size_t g = 0; g < words.size(); ++g) {
+      FeedbackBatch::patterns(packed_words[g], block,
+                              actual.data() + g * solutions.size(), isa);
+    }
+    end = Clock::now();
+    const auto elapsed = nanoseconds_per_pattern(start, end, pattern_count);
+    const bool match = actual == expected;
+    all_match = all_match && match;
+
+    std::cout << "FeedbackBatch " << FeedbackBatch::isa_name(isa);
+    std::cout << std::string(9 - std::string{FeedbackBatch::isa_name(isa)}
+                                     .size(),
+                             ' ');
+    std::cout << elapsed << " ns/pattern (" << baseline / elapsed << "x)"
+              << (match ? "" : " MISMATCH") << '\n';
+  }
+  return all_match ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,328 @@
+#include "harness.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+namespace harness {
+
+namespace {
+
+/// the measured values of one run, per iteration
+struct Result {
+  std::string name;
+  std::string run_name; ///< the name without the aggregate's suffix
+  std::uint64_t iterations{};
+  double real_ns{};
+  double cpu_ns{}; ///< CPU time of the process, every thread counted
+  double items_per_second{};
+  std::map<std::string, double> counters;
+  std::string aggregate; ///< "median" for a summary, empty for a run
+  std::size_t repetitions{1};
+  std::size_t repetition_index{};
+};
+
+struct Options {
+  std::string filter;
+  double min_time{0.5};
+  std::size_t repetitions{1};
+  std::string json;
+};
+
+/// runs this long or longer are never repeated to reach the minimum time
+constexpr std::uint64_t max_iterations{1'000'000'000};
+
+double seconds(const Clock::duration duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+/// process CPU time, in seconds
+double cpu_seconds() {
+  return static_cast<double>(std::clock()) / CLOCKS_PER_SEC;
+}
+
+/// CPU seconds spent in timed sections by the State running now; States
+/// don't nest, so one total is enough
+double timed_cpu{};
+
+/**
+ * @brief Run `function` with more and more iterations until it takes at
+ *        least `min_time`, as Google Benchmark does
+ */
+Result measure(const std::string &name, const Registry::Function &function,
+               const std::vector<std::int64_t> &args, const double min_time) {
+  std::uint64_t iterations{1};
+  for (;;) {
+    State state{iterations, args};
+    timed_cpu = 0;
+    function(state);
+    const auto elapsed = seconds(state.elapsed());
+    if (elapsed >= min_time || iterations >= max_iterations) {
+      Result result;
+      result.name = name;
+      result.run_name = name;
+      result.iterations = iterations;
+      result.real_ns = elapsed * 1e9 / static_cast<double>(iterations);
+      result.cpu_ns = timed_cpu * 1e9 / static_cast<double>(iterations);
+      if (state.items_processed() != 0 && elapsed > 0) {
+        result.items_per_second =
+            static_cast<double>(state.items_processed()) / elapsed;
+      }
+      result.counters = state.counters;
+      return result;
+    }
+    // aim past the minimum, but grow at most tenfold on a noisy estimate
+    const double factor =
+        elapsed > 0 ? std::min(10.0, min_time * 1.4 / elapsed) : 10.0;
+    iterations = std::min(
+        max_iterations,
+        std::max(iterations + 1, static_cast<std::uint64_t>(
+                                     static_cast<double>(iterations) *
+                                     factor)));
+  }
+}
+
+/// the median of every value of `runs`, reported like one more run
+Result median(const std::vector<Result> &runs) {
+  const auto middle = [&runs](auto member) {
+    std::vector<double> values;
+    for (const auto &run : runs) {
+      values.push_back(run.*member);
+    }
+    std::sort(values.begin(), values.end());
+    const auto half = values.size() / 2;
+    return values.size() % 2 == 1 ? values[half]
+                                  : (values[half - 1] + values[half]) / 2;
+  };
+  Result result = runs.front();
+  result.name += "_median";
+  result.aggregate = "median";
+  result.repetitions = runs.size();
+  result.real_ns = middle(&Result::real_ns);
+  result.cpu_ns = middle(&Result::cpu_ns);
+  result.items_per_second = middle(&Result::items_per_second);
+  return result;
+}
+
+/// `ns` in the largest unit that keeps it above one, to three digits
+std::string format_time(const double ns) {
+  const auto [value, unit] = ns >= 1e9   ? std::pair{ns / 1e9, " s"}
+                             : ns >= 1e6 ? std::pair{ns / 1e6, " ms"}
+                             : ns >= 1e3 ? std::pair{ns / 1e3, " us"}
+                                         : std::pair{ns, " ns"};
+  std::ostringstream out;
+  out << std::fixed << std::setprecision(value < 10 ? 2 : value < 100 ? 1 : 0)
+      << value << unit;
+  return out.str();
+}
+
+void print(const Result &result, const std::size_t width) {
+  std::cout << std::left << std::setw(static_cast<int>(width)) << result.name
+            << std::right << std::setw(12) << format_time(result.real_ns)
+            << std::setw(12) << format_time(result.cpu_ns) << std::setw(12)
+            << result.iterations;
+  if (result.items_per_second != 0) {
+    std::cout << " items_per_second=" << std::setprecision(4)
+              << result.items_per_second;
+  }
+  for (const auto &[counter, value] : result.counters) {
+    std::cout << ' ' << counter << '=' << value;
+  }
+  std::cout << '\n';
+}
+
+std::string quoted(const std::string &text) {
+  std::string result{"\""};
+  for (const char ch : text) {
+    if (ch == '"' || ch == '\\') {
+      result += '\\';
+    }
+    result += ch;
+  }
+  return result + '"';
+}
+
+/// the results in Google Benchmark's JSON format
+void write_json(std::ostream &out, const std::vector<Result> &results,
+                const char *executable) {
+  const auto now = std::time(nullptr);
+  std::tm local{};
+#if defined(_WIN32)
+  localtime_s(&local, &now);
+#else
+  localtime_r(&now, &local);
+#endif
+  out << std::setprecision(10);
+  out << "{\n  \"context\": {\n";
+  out << "    \"date\": \"" << std::put_time(&local, "%FT%T%z") << "\",\n";
+  out << "    \"executable\": " << quoted(executable) << ",\n";
+  out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << ",\n";
+#if defined(NDEBUG)
+  out << "    \"library_build_type\": \"release\"\n";
+#else
+  out << "    \"library_build_type\": \"debug\"\n";
+#endif
+  out << "  },\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const auto &result = results[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\n";
+    out << "      \"name\": " << quoted(result.name) << ",\n";
+    out << "      \"run_name\": " << quoted(result.run_name) << ",\n";
+    if (result.aggregate.empty()) {
+      out << "      \"run_type\": \"iteration\",\n";
+      out << "      \"repetition_index\": " << result.repetition_index
+          << ",\n";
+    } else {
+      out << "      \"run_type\": \"aggregate\",\n";
+      out << "      \"aggregate_name\": " << quoted(result.aggregate)
+          << ",\n";
+    }
+    out << "      \"repetitions\": " << result.repetitions << ",\n";
+    out << "      \"iterations\": " << result.iterations << ",\n";
+    out << "      \"real_time\": " << result.real_ns << ",\n";
+    out << "      \"cpu_time\": " << result.cpu_ns << ",\n";
+    out << "      \"time_unit\": \"ns\"";
+    if (result.items_per_second != 0) {
+      out << ",\n      \"items_per_second\": " << result.items_per_second;
+    }
+    for (const auto &[counter, value] : result.counters) {
+      out << ",\n      " << quoted(counter) << ": " << value;
+    }
+    out << "\n    }";
+  }
+  out << "\n  ]\n}\n";
+}
+
+/// stores `text` in `number` if all of it is a number of that type
+template <typename Number> bool parse_number(const char *text, Number *number) {
+  const auto *last = text + std::strlen(text);
+  Number parsed{};
+  const auto [end, error] = std::from_chars(text, last, parsed);
+  if (error != std::errc{} || end != last) {
+    return false;
+  }
+  *number = parsed;
+  return true;
+}
+
+} // namespace
+
+State::State(const std::uint64_t iterations, std::vector<std::int64_t> args)
+    : _iterations{iterations}, _remaining{iterations}, _args{std::move(args)} {
+}
+
+bool State::keep_running() {
+  if (_remaining == _iterations && !_running) {
+    resume_timing();
+  }
+  if (_remaining == 0) {
+    pause_timing();
+    return false;
+  }
+  --_remaining;
+  return true;
+}
+
+void State::pause_timing() {
+  if (_running) {
+    _elapsed += Clock::now() - _start;
+    timed_cpu += cpu_seconds();
+    _running = false;
+  }
+}
+
+void State::resume_timing() {
+  if (!_running) {
+    timed_cpu -= cpu_seconds();
+    _start = Clock::now();
+    _running = true;
+  }
+}
+
+void Registry::add(const std::string &name, Function function,
+                   std::vector<std::vector<std::int64_t>> args) {
+  if (args.empty()) {
+    _benchmarks.push_back(Benchmark{name, std::move(function), {}});
+    return;
+  }
+  for (auto &set : args) {
+    auto full_name = name;
+    for (const auto arg : set) {
+      full_name += '/' + std::to_string(arg);
+    }
+    _benchmarks.push_back(Benchmark{full_name, function, std::move(set)});
+  }
+}
+
+int Registry::run(const int argc, char *argv[]) const {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const bool has_value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--filter") == 0 && has_value) {
+      options.filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--min-time") == 0 && has_value &&
+               parse_number(argv[i + 1], &options.min_time)) {
+      ++i;
+    } else if (std::strcmp(argv[i], "--repetitions") == 0 && has_value &&
+               parse_number(argv[i + 1], &options.repetitions)) {
+      options.repetitions = std::max<std::size_t>(1, options.repetitions);
+      ++i;
+    } else if (std::strcmp(argv[i], "--json") == 0 && has_value) {
+      options.json = argv[++i];
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--filter TEXT] [--min-time SECONDS] [--repetitions N]"
+                   " [--json FILE]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<const Benchmark *> selected;
+  std::size_t width{9};
+  for (const auto &benchmark : _benchmarks) {
+    if (benchmark.name.find(options.filter) != std::string::npos) {
+      selected.push_back(&benchmark);
+      width = std::max(width, benchmark.name.size() + 8);
+    }
+  }
+  std::cout << std::left << std::setw(static_cast<int>(width)) << "Benchmark"
+            << std::right << std::setw(12) << "Time" << std::setw(12) << "CPU"
+            << std::setw(12) << "Iterations" << '\n'
+            << std::string(width + 36, '-') << '\n';
+
+  std::vector<Result> results;
+  for (const auto *benchmark : selected) {
+    std::vector<Result> runs;
+    for (std::size_t r = 0; r < options.repetitions; ++r) {
+      auto result = measure(benchmark->name, benchmark->function,
+                            benchmark->args, options.min_time);
+      result.repetitions = options.repetitions;
+      result.repetition_index = r;
+      print(result, width);
+      runs.push_back(std::move(result));
+    }
+    results.insert(results.end(), runs.begin(), runs.end());
+    if (options.repetitions > 1) {
+      results.push_back(median(runs));
+      print(results.back(), width);
+    }
+  }
+
+  if (!options.json.empty()) {
+    std::ofstream out(options.json);
+    if (!out.is_open()) {
+      std::cerr << "Failed to open file " << options.json << '\n';
+      return EXIT_FAILURE;
+    }
+    write_json(out, results, argv[0]);
+  }
+  return EXIT_SUCCESS;
+}
+
+} // namespace harness
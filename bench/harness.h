@@ -0,0 +1,116 @@
+#ifndef WORDLE_SOLVER_BENCH_HARNESS_HPP_
+#define WORDLE_SOLVER_BENCH_HARNESS_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * A small benchmark harness in the manner of Google Benchmark, so the suite
+ * builds without any dependency: benchmarks are functions taking a State,
+ * run until they've taken a minimum time, and the results can be written as
+ * JSON in Google Benchmark's format for comparing commits with its tools.
+ */
+namespace harness {
+
+using Clock = std::chrono::steady_clock;
+
+/// keep the compiler from optimizing away the computation of `value`
+template <typename T> void do_not_optimize(const T &value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+/**
+ * @class State
+ * @brief Runs the timed loop of one benchmark run:
+ *        `while (state.keep_running()) { ... }`
+ */
+class State {
+ public:
+  State(std::uint64_t iterations, std::vector<std::int64_t> args);
+
+  /// whether to run another iteration; starts the clock on the first call
+  [[nodiscard]] auto keep_running() -> bool;
+
+  /// stop the clock, for setup that shouldn't be measured
+  void pause_timing();
+  void resume_timing();
+
+  /// argument `index` the benchmark was registered with
+  [[nodiscard]] auto arg(const std::size_t index) const -> std::int64_t {
+    return _args[index];
+  }
+
+  /// items handled over all iterations, reported as items per second
+  void set_items_processed(const std::uint64_t items) { _items = items; }
+
+  /// extra values to report with the run, such as a problem size
+  std::map<std::string, double> counters;
+
+  [[nodiscard]] auto iterations() const -> std::uint64_t {
+    return _iterations;
+  }
+  [[nodiscard]] auto elapsed() const -> Clock::duration { return _elapsed; }
+  [[nodiscard]] auto items_processed() const -> std::uint64_t {
+    return _items;
+  }
+
+ private:
+  std::uint64_t _iterations;
+  std::uint64_t _remaining;
+  std::vector<std::int64_t> _args;
+  std::uint64_t _items{};
+  bool _running{};
+  Clock::time_point _start;
+  Clock::duration _elapsed{};
+};
+
+/**
+ * @class Registry
+ * @brief The benchmarks of a program, and its main function
+ */
+class Registry {
+ public:
+  using Function = std::function<void(State &)>;
+
+  /**
+   * @brief Add a benchmark, run once per set of arguments
+   * @param args Each set is appended to the name, as "name/1/2"; none runs
+   *        the benchmark once without arguments
+   */
+  void add(const std::string &name, Function function,
+           std::vector<std::vector<std::int64_t>> args = {});
+
+  /**
+   * @brief Run the benchmarks selected by the command line and print them
+   * @details --filter TEXT      only names containing TEXT \n
+   *          --min-time S       run each benchmark at least S seconds
+   *                             (default 0.5) \n
+   *          --repetitions N    run each benchmark N times and also report
+   *                             the median \n
+   *          --json FILE        also write the results to FILE as JSON
+   * @return The exit code for main
+   */
+  auto run(int argc, char *argv[]) const -> int;
+
+ private:
+  struct Benchmark {
+    std::string name;
+    Function function;
+    std::vector<std::int64_t> args;
+  };
+
+  std::vector<Benchmark> _benchmarks;
+};
+
+} // namespace harness
+
+#endif // WORDLE_SOLVER_BENCH_HARNESS_HPP_
@@ -0,0 +1,358 @@
+#include "harness.h"
+
+#include "constraints.h"
+#include "dictionary.h"
+#include "feedback.h"
+#include "feedback_batch.h"
+#include "feedback_rows.h"
+#include "guess_cache.h"
+#include "pattern_histogram.h"
+#include "thread_pool.h"
+#include "wordle_solver.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <numeric>
+
+namespace {
+
+using harness::do_not_optimize;
+using harness::State;
+
+const std::string all_words_file{"word_lists/all_words.txt"};
+const std::string all_solutions_file{"word_lists/all_solutions.txt"};
+
+/// guess and solution pairs spread over the word lists
+constexpr std::size_t pair_count{1024};
+
+/// the word every game starts with, whose feedback splits the candidates
+const PackedWord opening{"tarse"};
+
+/**
+ * The candidates `opening` leaves for its feedback with the closest to
+ * `size` of them, as all_solutions indices; Constraints gets the same ones.
+ * Benchmarks ask for sizes that occur, 228 (the largest), 99 and 20, so
+ * their names give the candidates they run with
+ */
+std::vector<std::uint32_t> candidates_near(const Dictionary &dictionary,
+                                           const std::int64_t size,
+                                           Feedback::Pattern *pattern) {
+  const auto &patterns = dictionary.patterns();
+  const auto *row = patterns.row(patterns.guesses().index_of(opening));
+  std::map<Feedback::Pattern, std::vector<std::uint32_t>> buckets;
+  for (std::uint32_t s = 0; s < dictionary.all_solutions().size(); ++s) {
+    buckets[row[s]].push_back(s);
+  }
+  const auto distance = [size](const auto &bucket) {
+    return std::abs(static_cast<std::int64_t>(bucket.second.size()) - size);
+  };
+  const auto best = std::min_element(
+      buckets.begin(), buckets.end(),
+      [&distance](const auto &lhs, const auto &rhs) {
+        return distance(lhs) < distance(rhs);
+      });
+  *pattern = best->first;
+  return best->second;
+}
+
+void register_benchmarks(harness::Registry *registry,
+                         const std::shared_ptr<const Dictionary> &dictionary) {
+  const auto words = dictionary->all_words().to_strings();
+  const auto solutions = dictionary->all_solutions().to_strings();
+  std::vector<std::pair<std::string, std::string>> pairs;
+  for (std::size_t i = 0; i < pair_count; ++i) {
+    pairs.emplace_back(words[i * 7919 % words.size()],
+                       solutions[i * 104729 % solutions.size()]);
+  }
+
+  registry->add("Feedback::feedback", [pairs](State &state) {
+    while (state.keep_running()) {
+      for (const auto &[guess, solution] : pairs) {
+        do_not_optimize(Feedback::feedback(guess, solution));
+      }
+    }
+    state.set_items_processed(state.iterations() * pairs.size());
+  });
+
+  registry->add("Feedback::pattern", [pairs](State &state) {
+    std::vector<std::pair<PackedWord, PackedWord>> packed;
+    for (const auto &[guess, solution] : pairs) {
+      packed.emplace_back(PackedWord{guess}, PackedWord{solution});
+    }
+    while (state.keep_running()) {
+      for (const auto &[guess, solution] : packed) {
+        do_not_optimize(Feedback::pattern(guess, solution));
+      }
+    }
+    state.set_items_processed(state.iterations() * packed.size());
+  });
+
+  registry->add("FeedbackBatch::patterns", [dictionary](State &state) {
+    const SolutionBlock block{dictionary->all_solutions()};
+    std::vector<Feedback::Pattern> out(block.size());
+    while (state.keep_running()) {
+      FeedbackBatch::patterns(opening, block, out.data());
+      do_not_optimize(out);
+    }
+    state.set_items_processed(state.iterations() * block.size());
+    state.counters["isa"] = static_cast<double>(FeedbackBatch::best_isa());
+  });
+
+  // what the solver scores a word with: counting its row's patterns over
+  // the candidates, then the entropy of the counts
+  registry->add("PatternHistogram::count", [dictionary](State &state) {
+    const auto &patterns = dictionary->patterns();
+    const auto *row = patterns.row(patterns.guesses().index_of(opening));
+    std::vector<std::uint32_t> candidates(dictionary->all_solutions().size());
+    std::iota(candidates.begin(), candidates.end(), 0);
+    PatternHistogram histogram;
+    while (state.keep_running()) {
+      histogram.clear();
+      histogram.count(row, candidates.begin(), candidates.end());
+      do_not_optimize(histogram);
+    }
+    state.set_items_processed(state.iterations() * candidates.size());
+  });
+
+  registry->add("PatternHistogram::entropy", [dictionary](State &state) {
+    const auto &patterns = dictionary->patterns();
+    const auto *row = patterns.row(patterns.guesses().index_of(opening));
+    std::vector<std::uint32_t> candidates(dictionary->all_solutions().size());
+    std::iota(candidates.begin(), candidates.end(), 0);
+    PatternHistogram histogram;
+    histogram.count(row, candidates.begin(), candidates.end());
+    while (state.keep_running()) {
+      do_not_optimize(histogram.entropy());
+    }
+  });
+
+  // the pruning passes: the first over every solution, later ones over the
+  // candidates the first left, with the feedback for the argument's count
+  registry->add(
+      "Constraints::filter/first",
+      [dictionary](State &state) {
+        Feedback::Pattern pattern{};
+        static_cast<void>(candidates_near(*dictionary, state.arg(0), &pattern));
+        Constraints constraints;
+        constraints.add(opening, pattern);
+        std::vector<std::uint32_t> all(dictionary->all_solutions().size());
+        std::iota(all.begin(), all.end(), 0);
+        std::vector<std::uint32_t> candidates;
+        while (state.keep_running()) {
+          state.pause_timing();
+          candidates = all;
+          state.resume_timing();
+          constraints.filter(dictionary->all_solutions(), &candidates);
+          do_not_optimize(candidates);
+        }
+        state.set_items_processed(state.iterations() * all.size());
+        state.counters["candidates"] = static_cast<double>(candidates.size());
+      },
+      {{228}, {99}});
+
+  registry->add(
+      "Constraints::filter/later",
+      [dictionary](State &state) {
+        Feedback::Pattern pattern{};
+        const auto before =
+            candidates_near(*dictionary, state.arg(0), &pattern);
+        // the second guess: the first remaining candidate, against the last
+        const auto guess = dictionary->all_solutions()[before.front()];
+        const auto second = Feedback::pattern(
+            guess, dictionary->all_solutions()[before.back()]);
+        Constraints constraints;
+        constraints.add(opening, pattern);
+        constraints.add(guess, second);
+        std::vector<std::uint32_t> candidates;
+        while (state.keep_running()) {
+          state.pause_timing();
+          candidates = before;
+          state.resume_timing();
+          constraints.filter(dictionary->all_solutions(), &candidates);
+          do_not_optimize(candidates);
+        }
+        state.set_items_processed(state.iterations() * before.size());
+        state.counters["candidates"] = static_cast<double>(candidates.size());
+      },
+      {{228}, {99}});
+
+  // Past the first turn a guess is WordleSolver::eval_entropies. Arguments:
+  // the candidates left by the first feedback, and the threads scoring.
+  registry->add(
+      "WordleSolver::eval_entropies",
+      [dictionary](State &state) {
+        Feedback::Pattern pattern{};
+        const auto candidates =
+            candidates_near(*dictionary, state.arg(0), &pattern);
+        const auto pool = std::make_shared<ThreadPool>(
+            static_cast<unsigned>(state.arg(1)));
+        WordleSolver prepared{dictionary};
+        prepared.set_thread_pool(pool);
+        static_cast<void>(prepared.guess());
+        prepared.accept_feedback(Feedback::to_string(pattern));
+        while (state.keep_running()) {
+          state.pause_timing();
+          auto solver = prepared;
+          state.resume_timing();
+          do_not_optimize(solver.guess());
+        }
+        state.counters["candidates"] = static_cast<double>(candidates.size());
+        state.counters["threads"] = static_cast<double>(pool->thread_count());
+      },
+      {{228, 1}, {228, 2}, {228, 4}, {99, 1}, {99, 2}, {99, 4}, {20, 1},
+       {20, 4}});
+
+  // the anytime search on the second turn, with the argument's budget in
+  // microseconds; coverage is the share of words scored or ruled out
+  registry->add(
+      "WordleSolver::guess(deadline)",
+      [dictionary](State &state) {
+        Feedback::Pattern pattern{};
+        static_cast<void>(candidates_near(*dictionary, 228, &pattern));
+        WordleSolver prepared{dictionary};
+        prepared.set_thread_count(1);
+        static_cast<void>(prepared.guess());
+        prepared.accept_feedback(Feedback::to_string(pattern));
+        double coverage{};
+        while (state.keep_running()) {
+          state.pause_timing();
+          auto solver = prepared;
+          state.resume_timing();
+          const auto timed = solver.guess(
+              WordleSolver::Clock::now() +
+              std::chrono::microseconds{state.arg(0)});
+          coverage = static_cast<double>(timed.covered) /
+                     static_cast<double>(timed.words);
+          do_not_optimize(timed);
+        }
+        state.counters["coverage"] = coverage;
+      },
+      {{100}, {1000}, {10000}, {100000}});
+
+  registry->add("WordleSolver::load_wordlist", [](State &state) {
+    std::size_t count{};
+    while (state.keep_running()) {
+      const auto list = WordleSolver::load_wordlist(all_words_file);
+      count = list.size();
+      do_not_optimize(list);
+    }
+    state.set_items_processed(state.iterations() * count);
+  });
+
+  // a solver only creates per-game state, so it's cheap next to a
+  // dictionary, which builds its pattern table unless it's mapped
+  registry->add("WordleSolver(dictionary)", [dictionary](State &state) {
+    while (state.keep_running()) {
+      WordleSolver solver{dictionary};
+      do_not_optimize(solver);
+    }
+  });
+
+  registry->add("Dictionary::load", [](State &state) {
+    while (state.keep_running()) {
+      do_not_optimize(Dictionary::load(all_words_file, all_solutions_file));
+    }
+  });
+
+  registry->add("Dictionary::map", [dictionary](State &state) {
+    const std::string file{"solver_bench_dictionary.bin"};
+    dictionary->save(file);
+    while (state.keep_running()) {
+      do_not_optimize(Dictionary::map(file));
+    }
+    std::filesystem::remove(file);
+  });
+
+  // whole games, one solver each, against a spread of solutions; with the
+  // argument set, the solvers share a guess cache warmed by the first round
+  registry->add(
+      "WordleSolver/game",
+      [dictionary, solutions](State &state) {
+        constexpr std::size_t games{64};
+        const auto cache =
+            state.arg(0) != 0 ? std::make_shared<GuessCache>() : nullptr;
+        while (state.keep_running()) {
+          for (std::size_t g = 0; g < games; ++g) {
+            const auto &solution = solutions[g * 37 % solutions.size()];
+            WordleSolver solver{dictionary};
+            solver.set_thread_count(1);
+            solver.set_guess_cache(cache);
+            for (int turn = 0; turn < 10; ++turn) {
+              const auto feedback =
+                  Feedback::feedback_string(solver.guess(), solution);
+              if (feedback == "ggggg") {
+                break;
+              }
+              solver.accept_feedback(feedback);
+            }
+          }
+        }
+        state.set_items_processed(state.iterations() * games);
+        if (cache) {
+          const auto statistics = cache->statistics();
+          state.counters["hit_rate"] =
+              static_cast<double>(statistics.hits) /
+              static_cast<double>(statistics.hits + statistics.misses);
+        }
+      },
+      {{0}, {1}});
+
+  // the same games without a pattern table, the solvers sharing feedback
+  // rows of the argument's bytes, warmed by the first round
+  const auto on_demand = std::make_shared<const Dictionary>(
+      dictionary->all_words(), dictionary->all_solutions(),
+      Dictionary::Storage::on_demand);
+  registry->add(
+      "WordleSolver/game_on_demand",
+      [on_demand, solutions](State &state) {
+        constexpr std::size_t games{64};
+        const auto rows = std::make_shared<FeedbackRows>(
+            static_cast<std::size_t>(state.arg(0)));
+        while (state.keep_running()) {
+          for (std::size_t g = 0; g < games; ++g) {
+            const auto &solution = solutions[g * 37 % solutions.size()];
+            WordleSolver solver{on_demand};
+            solver.set_thread_count(1);
+            solver.set_feedback_rows(rows);
+            for (int turn = 0; turn < 10; ++turn) {
+              const auto feedback =
+                  Feedback::feedback_string(solver.guess(), solution);
+              if (feedback == "ggggg") {
+                break;
+              }
+              solver.accept_feedback(feedback);
+            }
+          }
+        }
+        state.set_items_processed(state.iterations() * games);
+        const auto statistics = rows->statistics();
+        state.counters["hit_rate"] = statistics.hit_rate();
+        state.counters["bytes"] = static_cast<double>(statistics.bytes);
+      },
+      {{0}, {1 << 20}, {4 << 20}});
+}
+
+} // namespace
+
+/**
+ * Usage: wordle-bench [--filter TEXT] [--min-time SECONDS] [--repetitions N]
+ *                     [--json FILE]
+ *
+ * Run from the directory holding word_lists/. The JSON is in Google
+ * Benchmark's format, so its compare.py can diff two commits' results.
+ */
+int main(int argc, char *argv[]) {
+  if (!std::filesystem::exists(all_words_file) ||
+      !std::filesystem::exists(all_solutions_file)) {
+    std::cerr << "Cannot find " << all_words_file << " and "
+              << all_solutions_file << '\n';
+    return EXIT_FAILURE;
+  }
+  const auto dictionary = Dictionary::load(all_words_file, all_solutions_file);
+  harness::Registry registry;
+  register_benchmarks(&registry, dictionary);
+  return registry.run(argc, argv);
+}
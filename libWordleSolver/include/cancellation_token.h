@@ -0,0 +1,27 @@
+#ifndef WORDLE_SOLVER_INCLUDE_CANCELLATION_TOKEN_HPP_
+#define WORDLE_SOLVER_INCLUDE_CANCELLATION_TOKEN_HPP_
+
+#include <atomic>
+
+/**
+ * @class CancellationToken
+ * @brief Asks a running search to stop with the best it has found so far
+ * @details Any thread may cancel; the search polls the token between words,
+ *          so it stops within the time it takes to score one.
+ */
+class CancellationToken {
+ public:
+  void cancel() { _cancelled.store(true, std::memory_order_relaxed); }
+
+  /// make the token usable for another search
+  void reset() { _cancelled.store(false, std::memory_order_relaxed); }
+
+  [[nodiscard]] auto cancelled() const -> bool {
+    return _cancelled.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<bool> _cancelled{};
+};
+
+#endif // WORDLE_SOLVER_INCLUDE_CANCELLATION_TOKEN_HPP_
@@ -0,0 +1,61 @@
+#ifndef WORDLE_SOLVER_INCLUDE_CANDIDATE_PARTITION_HPP_
+#define WORDLE_SOLVER_INCLUDE_CANDIDATE_PARTITION_HPP_
+
+#include "feedback.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BasicCandidatePartition
+ * @brief Candidates grouped by the feedback one guess gives them
+ * @details A counting sort on a pattern table row: the candidates of each
+ *          pattern lie next to each other, in their original order.
+ * @tparam  Feedback The BasicFeedback of the word length
+ */
+template <typename Feedback> class BasicCandidatePartition {
+ public:
+  using Pattern = typename Feedback::Pattern;
+
+  /**
+   * @param row The patterns of the guess against every solution
+   * @param first,last The candidates, as solution indices
+   */
+  BasicCandidatePartition(const Pattern *row, const std::uint32_t *first,
+                          const std::uint32_t *last)
+      : _members(static_cast<std::size_t>(last - first)) {
+    for (auto it = first; it != last; ++it) {
+      ++_offsets[row[*it] + 1];
+    }
+    for (std::size_t p = 1; p < _offsets.size(); ++p) {
+      _offsets[p] += _offsets[p - 1];
+    }
+    auto next = _offsets;
+    for (auto it = first; it != last; ++it) {
+      _members[next[row[*it]]++] = *it;
+    }
+  }
+
+  /// candidates giving `pattern`
+  [[nodiscard]] auto size(const std::size_t pattern) const -> std::uint32_t {
+    return _offsets[pattern + 1] - _offsets[pattern];
+  }
+  [[nodiscard]] auto begin(const std::size_t pattern) const
+      -> const std::uint32_t * {
+    return _members.data() + _offsets[pattern];
+  }
+  [[nodiscard]] auto end(const std::size_t pattern) const
+      -> const std::uint32_t * {
+    return _members.data() + _offsets[pattern + 1];
+  }
+
+ private:
+  std::vector<std::uint32_t> _members;
+  std::array<std::uint32_t, Feedback::pattern_count + 1> _offsets{};
+};
+
+/// five-letter candidates grouped by pattern
+using CandidatePartition = BasicCandidatePartition<Feedback>;
+
+#endif // WORDLE_SOLVER_INCLUDE_CANDIDATE_PARTITION_HPP_
@@ -0,0 +1,87 @@
+#ifndef WORDLE_SOLVER_INCLUDE_CONSTRAINTS_HPP_
+#define WORDLE_SOLVER_INCLUDE_CONSTRAINTS_HPP_
+
+#include "feedback.h"
+#include "word_list.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BasicConstraints
+ * @brief Everything the feedback so far says about the solution
+ * @details Accumulated feedback is compiled into a mask of allowed letters
+ *          for each position and a minimum and maximum count for each letter.
+ *          A word passes the constraints exactly when it would have produced
+ *          every pattern seen so far, and checking it costs a few mask tests.
+ */
+template <int N, typename Alphabet = Latin> class BasicConstraints {
+ public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+  using WordList = BasicWordList<N, Alphabet>;
+  using Feedback = BasicFeedback<N, Alphabet>;
+
+  BasicConstraints();
+
+  /**
+   * @brief Narrow the constraints with the feedback for one guess
+   * @param guess The word that was played
+   * @param pattern The feedback the game gave for it
+   */
+  void add(PackedWord guess, typename Feedback::Pattern pattern);
+
+  /// true if `word` is consistent with all the feedback added so far
+  [[nodiscard]] auto allows(PackedWord word) const -> bool;
+
+  /**
+   * @brief Whether hard mode lets `word` be played next: every green letter
+   *        stays in place and every revealed letter is used, as often as it
+   *        has been revealed
+   * @note  Weaker than BasicConstraints::allows, which also rules out gray
+   *        letters and yellow positions; every allowed word is a valid guess
+   */
+  [[nodiscard]] auto allows_guess(PackedWord word) const -> bool;
+
+  /**
+   * @brief Remove the words that are not allowed, keeping the order
+   * @param words The list the indices refer to
+   * @param [in,out] indices Indices into `words`, compacted in place
+   * @param [out] removed If not nullptr, gets the indices taken out
+   */
+  void filter(const WordList &words, std::vector<std::uint32_t> *indices,
+              std::vector<std::uint32_t> *removed = nullptr) const;
+
+  /// letters allowed at `position`, one bit per alphabet index
+  [[nodiscard]] auto allowed(const int position) const -> std::uint32_t {
+    return _allowed[position];
+  }
+  [[nodiscard]] auto min_count(const int letter) const -> int {
+    return _min_count[letter];
+  }
+  [[nodiscard]] auto max_count(const int letter) const -> int {
+    return _max_count[letter];
+  }
+  /// letters the solution is known to contain
+  [[nodiscard]] auto required() const -> std::uint32_t { return _required; }
+
+ private:
+  static constexpr std::uint32_t all_letters =
+      (1U << PackedWord::alphabet_size) - 1;
+
+  std::array<std::uint32_t, PackedWord::length> _allowed{};
+  std::array<std::uint8_t, PackedWord::alphabet_size> _min_count{};
+  std::array<std::uint8_t, PackedWord::alphabet_size> _max_count{};
+
+  /// the green letter at each position as a bit, or 0 if there is none
+  std::array<std::uint32_t, PackedWord::length> _green{};
+
+  std::uint32_t _required{}; ///< letters with a minimum count
+  std::uint32_t _repeated{}; ///< letters with a minimum count above 1
+  std::uint32_t _counted{};  ///< letters whose count must be checked
+};
+
+/// constraints on a five-letter solution
+using Constraints = BasicConstraints<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_CONSTRAINTS_HPP_
@@ -0,0 +1,109 @@
+#ifndef WORDLE_SOLVER_INCLUDE_DECISION_TREE_HPP_
+#define WORDLE_SOLVER_INCLUDE_DECISION_TREE_HPP_
+
+#include "feedback.h"
+#include "packed_word.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+template <int N, typename Alphabet> class BasicDictionary;
+class ThreadPool;
+
+/**
+ * @class BasicDecisionTree
+ * @brief A complete strategy: the guess to make after any feedback, for
+ *        every solution
+ * @details Built offline by an exact search over the few best guesses by
+ *          entropy at every node. Playing it costs one child lookup per turn;
+ *          WordleSolver::set_decision_tree plays one.
+ */
+template <int N, typename Alphabet = Latin> class BasicDecisionTree {
+ public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+  using Feedback = BasicFeedback<N, Alphabet>;
+  using Dictionary = BasicDictionary<N, Alphabet>;
+
+  /// what DecisionTree::build minimizes
+  enum class Objective : std::uint32_t {
+    average,    ///< guesses, summed over all solutions
+    worst_case, ///< guesses of the hardest solution
+  };
+
+  /// returned by DecisionTree::next when the tree doesn't go on
+  static constexpr std::uint32_t npos = static_cast<std::uint32_t>(-1);
+
+  /**
+   * @brief Search for the best tree
+   * @param candidates Guesses tried at every node: this many best by
+   *        entropy, and the best candidate solution. Cost grows quickly with
+   *        it
+   * @param pool Runs subtrees near the root in parallel
+   * @throws std::invalid_argument for a dictionary without a pattern table
+   */
+  [[nodiscard]] static auto
+  build(const std::shared_ptr<const Dictionary> &dictionary,
+        std::size_t candidates, Objective objective, ThreadPool *pool)
+      -> std::shared_ptr<const BasicDecisionTree>;
+
+  /**
+   * @brief Read a tree written by DecisionTree::save
+   * @throws std::runtime_error if the file can't be read, isn't a tree, or
+   *         was built for a different dictionary
+   */
+  [[nodiscard]] static auto load(const std::string &file_name,
+                                 const Dictionary &dictionary)
+      -> std::shared_ptr<const BasicDecisionTree>;
+
+  /// @throws std::runtime_error if the file can't be written
+  void save(const std::string &file_name) const;
+
+  /// the node every game starts at
+  [[nodiscard]] static constexpr auto root() -> std::uint32_t { return 0; }
+
+  /// the guess to make at `node`
+  [[nodiscard]] auto guess(const std::uint32_t node) const -> PackedWord {
+    return PackedWord::from_key(_nodes[node].guess);
+  }
+
+  /// the node `pattern` leads to from `node`, or DecisionTree::npos
+  [[nodiscard]] auto next(std::uint32_t node,
+                          typename Feedback::Pattern pattern) const
+      -> std::uint32_t;
+
+  [[nodiscard]] auto objective() const -> Objective { return _objective; }
+  /// guesses to solve every solution, added up
+  [[nodiscard]] auto total_guesses() const -> std::uint64_t {
+    return _total_guesses;
+  }
+  /// guesses to solve the hardest solution
+  [[nodiscard]] auto max_guesses() const -> std::uint32_t {
+    return _max_guesses;
+  }
+  [[nodiscard]] auto size() const -> std::size_t { return _nodes.size(); }
+
+ private:
+  struct Node {
+    typename PackedWord::Key guess; ///< PackedWord::key
+    std::uint32_t first_child; ///< into _children
+    std::uint32_t child_count;
+  };
+  struct Child {
+    std::uint32_t pattern; ///< a Feedback::Pattern; sorted within a node
+    std::uint32_t node;
+  };
+
+  Objective _objective{};
+  std::uint64_t _fingerprint{};
+  std::uint64_t _total_guesses{};
+  std::uint32_t _max_guesses{};
+  std::vector<Node> _nodes;
+  std::vector<Child> _children;
+};
+
+/// the decision tree of five-letter games
+using DecisionTree = BasicDecisionTree<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_DECISION_TREE_HPP_
@@ -0,0 +1,147 @@
+#ifndef WORDLE_SOLVER_INCLUDE_DICTIONARY_HPP_
+#define WORDLE_SOLVER_INCLUDE_DICTIONARY_HPP_
+
+#include "pattern_table.h"
+#include "word_list.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * @class BasicDictionary
+ * @brief The word lists and pattern table a game is played with
+ * @details Immutable once built, so one dictionary can be shared by any
+ *          number of solvers, on any threads, through a
+ *          `std::shared_ptr<const Dictionary>`.
+ */
+template <int N, typename Alphabet = Latin> class BasicDictionary {
+ public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+  using WordList = BasicWordList<N, Alphabet>;
+  using PatternTable = BasicPatternTable<N, Alphabet>;
+
+  /// how the feedback of the words is looked up
+  enum class Storage {
+    table,     ///< every word against every solution, computed up front
+    on_demand, ///< computed by each solver's FeedbackRows as it searches
+  };
+
+  /**
+   * @param all_words All valid guesses
+   * @param all_solutions All possible solutions
+   * @param storage Storage::on_demand keeps only the words, for machines
+   *        without room for the table: about 30 MB for five letters. Solvers
+   *        then search more slowly, and the opening book, decision tree and
+   *        multi-board solver, which need the table, throw
+   *        std::invalid_argument
+   */
+  BasicDictionary(WordList all_words, WordList all_solutions,
+                  Storage storage = Storage::table);
+
+  /**
+   * @brief   Load a dictionary from two word list files, one word per line
+   * @note    Exits the program if a file can't be read, like
+   *          WordleSolver::load_wordlist
+   */
+  [[nodiscard]] static auto load(std::string_view all_words_file,
+                                 std::string_view all_solutions_file,
+                                 Storage storage = Storage::table)
+      -> std::shared_ptr<const BasicDictionary>;
+
+  /**
+   * @brief   Build a dictionary from word lists held in memory, one word per
+   *          line, e.g. embedded in the program
+   */
+  [[nodiscard]] static auto from_memory(const char *all_words,
+                                        unsigned int all_words_length,
+                                        const char *all_solutions,
+                                        unsigned int all_solutions_length)
+      -> std::shared_ptr<const BasicDictionary>;
+
+  /// optional parts of a binary dictionary file, for Dictionary::save
+  enum Section : unsigned {
+    letter_masks = 1U << 0U,  ///< mapped as is; otherwise rebuilt on load
+    pattern_table = 1U << 1U, ///< mapped as is; otherwise rebuilt on load
+  };
+
+  /**
+   * @brief   Map a dictionary written by Dictionary::save into memory
+   * @details The words and pattern table are used where they lie in the
+   *          file, so this takes microseconds and processes mapping the same
+   *          file share its pages. The header and words are checked; the
+   *          pattern table is trusted.
+   * @throws  std::runtime_error if the file can't be mapped or isn't a
+   *          dictionary
+   */
+  [[nodiscard]] static auto map(const std::string &file_name)
+      -> std::shared_ptr<const BasicDictionary>;
+
+  /**
+   * @brief   Write the dictionary in its binary format
+   * @param   sections Section flags to include besides the words; there is
+   *          no pattern table to include with Storage::on_demand
+   * @throws  std::runtime_error if the file can't be written
+   */
+  void save(const std::string &file_name,
+            unsigned sections = letter_masks | pattern_table) const;
+
+  /**
+   * @brief   The dictionary in "word_lists/all_words.txt" and
+   *          "word_lists/all_solutions.txt", loaded on first use
+   * @note    Other word lengths read "word_lists/all_words_N.txt" and
+   *          "word_lists/all_solutions_N.txt", N being the length
+   */
+  [[nodiscard]] static auto shared_default()
+      -> std::shared_ptr<const BasicDictionary>;
+
+  /**
+   * @brief   The word lists compiled into the library from "word_lists/",
+   *          built on first use without reading any files
+   * @throws  std::runtime_error for anything but five Latin letters, the
+   *          only lists compiled in
+   */
+  [[nodiscard]] static auto embedded()
+      -> std::shared_ptr<const BasicDictionary>;
+
+  /// all valid guesses
+  [[nodiscard]] auto all_words() const -> const WordList & {
+    return _all_words;
+  }
+  /// all possible solutions
+  [[nodiscard]] auto all_solutions() const -> const WordList & {
+    return _all_solutions;
+  }
+  /// feedback of every word against every solution
+  /// @note Only the rows are numbered without has_table()
+  [[nodiscard]] auto patterns() const -> const PatternTable & {
+    return _patterns;
+  }
+
+  /// false for Storage::on_demand
+  [[nodiscard]] auto has_table() const -> bool { return _patterns.filled(); }
+
+  /// hash of both word lists, to check that saved data belongs to them
+  [[nodiscard]] auto fingerprint() const -> std::uint64_t {
+    return _fingerprint;
+  }
+
+ private:
+  /// a dictionary whose parts were loaded by Dictionary::map
+  BasicDictionary(WordList all_words, WordList all_solutions,
+                  PatternTable patterns);
+
+  /// computes _fingerprint from the word lists
+  void fingerprint_words();
+
+  WordList _all_words;
+  WordList _all_solutions;
+  PatternTable _patterns;
+  std::uint64_t _fingerprint{};
+};
+
+/// the dictionary of five-letter words
+using Dictionary = BasicDictionary<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_DICTIONARY_HPP_
@@ -1,6 +1,9 @@
 #ifndef WORDLE_SOLVER_INCLUDE_ENTROPY_HPP_
 #define WORDLE_SOLVER_INCLUDE_ENTROPY_HPP_
 
+#include <array>
+#include <cstdint>
+
 class Entropy {
 public:
   /**
@@ -16,6 +19,47 @@ public:
    *          passes that map to this function to get the entropy for that word
    */
   template <typename Map> static double entropy(Map &feedback);
+
+  /**
+   * @brief   Calculates the expected information from a pattern histogram
+   * @details Uses H = log2(N) - sum(n * log2(n)) / N, where n is the count of
+   *          each pattern and N is the total, so no division happens per
+   *          bucket and n * log2(n) comes from a lookup table. The sum is
+   *          taken in fixed point, as by n_log2_n_fixed, so every histogram
+   *          of the same counts has the same entropy to the last bit
+   * @param   counts The number of solutions giving each feedback pattern
+   * @param   total The sum of counts
+   * @return  The expected information, in bits, for a word
+   */
+  template <std::size_t N>
+  static double entropy(const std::array<std::uint32_t, N> &counts,
+                        std::uint32_t total);
+
+  /// n * log2(n), read from a precomputed table when n is small enough
+  static double n_log2_n(std::uint32_t n);
+
+  /**
+   * @brief   n * log2(n) in fixed point, scaled by 2^fixed_point_bits
+   * @details Rounding each term to an integer makes their sum exact, so a
+   *          sum kept up to date as counts change equals one counted afresh,
+   *          whatever the order. The rounding moves an entropy by at most
+   *          2^-(fixed_point_bits + 1)
+   */
+  static std::int64_t n_log2_n_fixed(std::uint32_t n);
+
+  /**
+   * @brief   The entropy of a histogram from the sum of n_log2_n_fixed over
+   *          its counts
+   * @param   total The sum of the counts
+   */
+  static double entropy_of_sum(std::int64_t sum, std::uint32_t total);
+
+  /// fraction bits of n_log2_n_fixed
+  static constexpr int fixed_point_bits = 32;
+
+private:
+  /// entries in the n * log2(n) table, enough for any solution list
+  static constexpr std::uint32_t n_log2_n_table_size = 4096;
 };
 
 #include "entropy.inl"
@@ -18,4 +18,56 @@ template <typename Map> double Entropy::entropy(Map &feedback) {
   return -neg_entropy; // two wrongs make a right ... right?
 }
 
+template <std::size_t N>
+double Entropy::entropy(const std::array<std::uint32_t, N> &counts,
+                        const std::uint32_t total) {
+  if (total == 0) {
+    return 0.0;
+  }
+  std::int64_t sum{};
+  for (const auto count : counts) {
+    sum += n_log2_n_fixed(count);
+  }
+  return entropy_of_sum(sum, total);
+}
+
+inline double Entropy::n_log2_n(const std::uint32_t n) {
+  static const auto table = [] {
+    std::array<double, n_log2_n_table_size> values{};
+    for (std::uint32_t i = 2; i < n_log2_n_table_size; ++i) {
+      values[i] = i * std::log2(static_cast<double>(i));
+    }
+    return values;
+  }();
+  if (n < n_log2_n_table_size) {
+    return table[n];
+  }
+  return n * std::log2(static_cast<double>(n));
+}
+
+inline std::int64_t Entropy::n_log2_n_fixed(const std::uint32_t n) {
+  constexpr double scale = std::uint64_t{1} << fixed_point_bits;
+  static const auto table = [] {
+    std::array<std::int64_t, n_log2_n_table_size> values{};
+    for (std::uint32_t i = 2; i < n_log2_n_table_size; ++i) {
+      values[i] = std::llround(n_log2_n(i) * scale);
+    }
+    return values;
+  }();
+  if (n < n_log2_n_table_size) {
+    return table[n];
+  }
+  return std::llround(n_log2_n(n) * scale);
+}
+
+inline double Entropy::entropy_of_sum(const std::int64_t sum,
+                                      const std::uint32_t total) {
+  if (total == 0) {
+    return 0.0;
+  }
+  constexpr double scale = std::uint64_t{1} << fixed_point_bits;
+  return std::log2(static_cast<double>(total)) -
+         static_cast<double>(sum) / scale / static_cast<double>(total);
+}
+
 #endif // ENTROPY_INL
\ No newline at end of file
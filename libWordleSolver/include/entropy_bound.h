@@ -0,0 +1,47 @@
+#ifndef WORDLE_SOLVER_INCLUDE_ENTROPY_BOUND_HPP_
+#define WORDLE_SOLVER_INCLUDE_ENTROPY_BOUND_HPP_
+
+#include "packed_word.h"
+#include "word_list.h"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BasicEntropyBound
+ * @brief A cheap upper bound on the entropy of a guess over a candidate set
+ * @details The entropy of a pattern is at most the sum of the entropies of
+ *          its colors, one per letter. The color at a position is green with
+ *          the share of candidates having the guessed letter there, and
+ *          yellow at most with the share of the others containing the letter
+ *          anywhere, which caps its entropy. The sum is capped by log2 of
+ *          the number of candidates. Looking up a guess costs one addition
+ *          per letter.
+ */
+template <int N, typename Alphabet = Latin> class BasicEntropyBound {
+ public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+  using WordList = BasicWordList<N, Alphabet>;
+
+  /**
+   * @param solutions The words `candidates` index
+   * @param candidates The solutions still possible
+   */
+  BasicEntropyBound(const WordList &solutions,
+                    const std::vector<std::uint32_t> &candidates);
+
+  /// bits `guess` can gain at most; never less than its entropy
+  [[nodiscard]] auto operator()(PackedWord guess) const -> double;
+
+ private:
+  /// the bound of each letter at each position
+  std::array<std::array<double, PackedWord::alphabet_size>, PackedWord::length>
+      _position_bounds{};
+  double _set_bound{}; ///< log2 of the number of candidates
+};
+
+/// the entropy bound of five-letter guesses
+using EntropyBound = BasicEntropyBound<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_ENTROPY_BOUND_HPP_
@@ -0,0 +1,63 @@
+#ifndef WORDLE_SOLVER_INCLUDE_EXPECTED_GUESSES_HPP_
+#define WORDLE_SOLVER_INCLUDE_EXPECTED_GUESSES_HPP_
+
+#include "pattern_table.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+/**
+ * @class BasicExpectedGuesses
+ * @brief Scores a guess by the number of guesses it takes to solve, looking
+ *        two guesses ahead
+ * @details The first guess splits the candidates by feedback. Each part is
+ *          then split again by the best second guess, and the parts left
+ *          after that are scored with ExpectedGuesses::estimate.
+ */
+template <int N, typename Alphabet = Latin> class BasicExpectedGuesses {
+ public:
+  using PatternTable = BasicPatternTable<N, Alphabet>;
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * @param patterns The dictionary's pattern table
+   * @param second_guesses Rows the second guess is chosen from
+   * @param deadline Give up on a score once this passes
+   */
+  BasicExpectedGuesses(const PatternTable &patterns,
+                       const std::vector<std::uint32_t> &second_guesses,
+                       Clock::time_point deadline);
+
+  /**
+   * @param row The first guess
+   * @param candidates The solutions still possible, as column indices
+   * @return The expected guesses to solve, counting `row`, or nothing if
+   *         the deadline passed first
+   */
+  [[nodiscard]] auto operator()(std::uint32_t row,
+                                const std::vector<std::uint32_t> &candidates)
+      const -> std::optional<double>;
+
+  /// guesses expected to take from `candidates` left, beyond the last split
+  [[nodiscard]] static auto estimate(std::size_t candidates) -> double;
+
+ private:
+  /**
+   * @return The guesses expected after the first, for the candidates one
+   *         pattern left, or nothing if the deadline passed first
+   */
+  [[nodiscard]] auto second_ply(const std::uint32_t *first,
+                                const std::uint32_t *last) const
+      -> std::optional<double>;
+
+  const PatternTable &_patterns;
+  const std::vector<std::uint32_t> &_second_guesses;
+  Clock::time_point _deadline;
+};
+
+/// the lookahead for five-letter guesses
+using ExpectedGuesses = BasicExpectedGuesses<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_EXPECTED_GUESSES_HPP_
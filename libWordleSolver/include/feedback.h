@@ -1,23 +1,42 @@
 #ifndef WORDLE_SOLVER_INCLUDE_FEEDBACK_HPP_
 #define WORDLE_SOLVER_INCLUDE_FEEDBACK_HPP_
 
-#include "wordle_solver.h"
+#include "packed_word.h"
 
 #include <algorithm>
 #include <bitset>
+#include <cstdint>
+#include <string>
+#include <type_traits>
 
-class Feedback {
+template <int N, typename Alphabet = Latin> class BasicFeedback {
 public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+
   /// number of bits for a character's feedback code
   static constexpr int feedback_char_bits = 2;
 
   /// number of bits for a word's feedback code
-  static constexpr int feedback_word_bits =
-      feedback_char_bits * WordleSolver::word_len;
+  static constexpr int feedback_word_bits = feedback_char_bits * N;
 
   using Code_element = std::bitset<feedback_char_bits>;
   using Code = std::bitset<feedback_word_bits>;
 
+  /// number of distinct patterns, 3^word_len
+  static constexpr int pattern_count = [] {
+    int count{1};
+    for (int i = 0; i < N; ++i) {
+      count *= 3;
+    }
+    return count;
+  }();
+
+  /// base-3 feedback code: one digit per character, first character most
+  /// significant; gray (0), yellow (1), green (2). One byte up to five
+  /// letters, two beyond
+  using Pattern = std::conditional_t<pattern_count <= 256, std::uint8_t,
+                                     std::uint16_t>;
+
   /**
    * @brief   Used by the solver to create a map of feedback types for a certain
    *          word.
@@ -28,6 +47,27 @@ public:
    */
   static Code feedback(const std::string &guess, const std::string &solution);
 
+  /**
+   * @brief   Compact form of Feedback::feedback, used to index the pattern
+   *          table and pattern histograms
+   * @details Scores like the game does: exact matches are green first, then
+   *          each remaining guess letter, left to right, is yellow only while
+   *          the solution still has an unmatched copy of it. For example,
+   *          "nanny" (guess) to "ninja" (solution) gives "gygxx".
+   * @param   guess test string
+   * @param   solution target string
+   * @return  The base-3 pattern, in [0, Feedback::pattern_count)
+   */
+  static Pattern pattern(PackedWord guess, PackedWord solution);
+
+  /**
+   * @brief   Feedback::pattern for words given as text, as are those of
+   *          Feedback::feedback and Feedback::feedback_string
+   * @throws  std::invalid_argument unless both are `N` letters of the
+   *          alphabet
+   */
+  static Pattern pattern(const std::string &guess, const std::string &solution);
+
   /**
    * @brief   Gives feedback by comparing guess to solution
    * @param   guess test string
@@ -40,38 +80,26 @@ public:
   static std::string feedback_string(const std::string &guess,
                                      const std::string &solution);
 
+  /// "xygxx"-style string of a pattern
+  static std::string to_string(Pattern pattern);
+
+  /**
+   * @param   feedback "xygxx"-style feedback, as given by the game
+   * @return  The matching pattern; characters other than 'y' and 'g' are gray
+   */
+  static Pattern to_pattern(const std::string &feedback);
+
 private:
   /**
    * @param [in,out] target Set the bits, as dictated by the section parameter,
    * to the source bits
    * @param source The bit values we wish target to take on
-   * @param section One of 5 partitions of the target bitset
+   * @param section One of N partitions of the target bitset
    */
   static void set_bits(Code *target, Code_element source, std::size_t section);
-
-  /**
-   * @brief Give feedback for a specific character
-   * @param   ch_test Character n of test string
-   * @param   ch_solution Character n of solution string
-   * @param   solution solution string
-   * @return 00 -   gray    - no match \n
-   *         01 -   yellow  - found in solution \n
-   *         10 -   green   - the character is in the correct position
-   */
-  static Code_element feedback_element(char ch_test, char ch_solution,
-                                       const std::string &solution);
-
-  /**
-   * @brief   Give feedback for a specific character
-   * @param   ch_test Character n of test string
-   * @param   ch_solution Character n of solution string
-   * @param   solution solution string
-   * @return  `x` -   gray    - no match \n
-   *          `y` -   yellow  - found in solution \n
-   *          `g` -   green   - the character is in the correct position
-   */
-  static char feedback_element_char(char ch_test, char ch_solution,
-                                    const std::string &solution);
 };
 
+/// feedback for the five-letter words of the original game
+using Feedback = BasicFeedback<5>;
+
 #endif // WORDLE_SOLVER_INCLUDE_FEEDBACK_HPP_
@@ -0,0 +1,82 @@
+#ifndef WORDLE_SOLVER_INCLUDE_FEEDBACK_BATCH_HPP_
+#define WORDLE_SOLVER_INCLUDE_FEEDBACK_BATCH_HPP_
+
+#include "feedback.h"
+#include "word_list.h"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BasicSolutionBlock
+ * @brief Solution words stored letter-by-letter (struct of arrays)
+ * @details Letter i of every solution is contiguous, stored as an alphabet
+ *          index and padded with zeros to a multiple of
+ *          SolutionBlock::lane_count, so a vector register can load the same
+ *          letter of many solutions at once.
+ */
+template <int N, typename Alphabet = Latin> class BasicSolutionBlock {
+ public:
+  /// solutions handled per iteration by the widest kernel
+  static constexpr std::size_t lane_count = 32;
+
+  BasicSolutionBlock() = default;
+  explicit BasicSolutionBlock(const BasicWordList<N, Alphabet> &solutions);
+
+  [[nodiscard]] auto size() const -> std::size_t { return _size; }
+  [[nodiscard]] auto padded_size() const -> std::size_t {
+    return _padded_size;
+  }
+
+  /// letter `position` of every solution, padded_size() entries
+  [[nodiscard]] auto letters(const int position) const
+      -> const std::uint8_t * {
+    return _letters.data() + position * _padded_size;
+  }
+
+ private:
+  std::size_t _size{};
+  std::size_t _padded_size{};
+  std::vector<std::uint8_t> _letters;
+};
+
+/**
+ * @class FeedbackBatch
+ * @brief Feedback patterns of one guess against a whole SolutionBlock
+ * @details Equivalent to calling Feedback::pattern for every solution, but
+ *          vectorized: AVX2 scores 32 solutions per step, SSE4.2 scores 16.
+ *          The widest kernel the CPU supports is chosen at runtime; other
+ *          builds, and words longer than five letters, whose patterns don't
+ *          fit a byte, fall back to a scalar loop.
+ */
+class FeedbackBatch {
+ public:
+  enum class Isa { scalar, sse42, avx2 };
+
+  /// the widest instruction set usable on this machine
+  [[nodiscard]] static auto best_isa() -> Isa;
+
+  [[nodiscard]] static auto isa_name(Isa isa) -> const char *;
+
+  /**
+   * @param guess test word
+   * @param block target words
+   * @param [out] out Receives block.size() patterns
+   */
+  template <int N, typename Alphabet>
+  static void patterns(BasicPackedWord<N, Alphabet> guess,
+                       const BasicSolutionBlock<N, Alphabet> &block,
+                       typename BasicFeedback<N, Alphabet>::Pattern *out);
+
+  /// as above, with an explicit kernel; `isa` must be supported
+  template <int N, typename Alphabet>
+  static void patterns(BasicPackedWord<N, Alphabet> guess,
+                       const BasicSolutionBlock<N, Alphabet> &block,
+                       typename BasicFeedback<N, Alphabet>::Pattern *out,
+                       Isa isa);
+};
+
+/// a block of five-letter solutions
+using SolutionBlock = BasicSolutionBlock<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_FEEDBACK_BATCH_HPP_
@@ -0,0 +1,169 @@
+#ifndef WORDLE_SOLVER_INCLUDE_FEEDBACK_ROWS_HPP_
+#define WORDLE_SOLVER_INCLUDE_FEEDBACK_ROWS_HPP_
+
+#include "feedback_batch.h"
+#include "guess_cache.h"
+#include "pattern_histogram.h"
+#include "word_list.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class BasicFeedbackRows
+ * @brief Pattern table rows computed on demand, for a dictionary without a
+ *        table, shared by solvers
+ * @details A row holds the patterns of one guess against the candidates of
+ *          a turn only, computed with FeedbackBatch when first needed, so
+ *          memory follows the candidates rather than the dictionary. Rows
+ *          are kept by candidate set in a cache of bounded size: games
+ *          reaching the same candidates, as many do after the same opening,
+ *          search the same rows. The cache is split into shards, each behind
+ *          its own mutex and evicting its least recently used rows when over
+ *          its share of the budget, so solvers on many threads rarely wait
+ *          for each other.
+ */
+template <int N, typename Alphabet = Latin> class BasicFeedbackRows {
+ public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+  using WordList = BasicWordList<N, Alphabet>;
+  using Feedback = BasicFeedback<N, Alphabet>;
+  using Pattern = typename Feedback::Pattern;
+  using PatternHistogram = BasicPatternHistogram<Feedback>;
+
+  /// the candidates of a turn, which rows are computed against
+  class Candidates {
+   public:
+    Candidates() = default;
+
+    /**
+     * @param fingerprint The dictionary's, so dictionaries can share rows
+     * @param indices Indices into `all_solutions`
+     */
+    Candidates(std::uint64_t fingerprint, const WordList &all_solutions,
+               const std::vector<std::uint32_t> &indices);
+
+    [[nodiscard]] auto size() const -> std::size_t { return _block.size(); }
+
+   private:
+    friend class BasicFeedbackRows;
+
+    GuessCache::Key _key;
+    BasicSolutionBlock<N, Alphabet> _block;
+  };
+
+  struct Statistics {
+    std::uint64_t hits{};
+    std::uint64_t misses{}; ///< rows computed
+    std::uint64_t evictions{};
+    std::size_t rows{};   ///< rows held now
+    std::size_t bytes{};  ///< their bytes, patterns and bookkeeping
+    std::size_t budget{}; ///< bytes they may take at most
+
+    [[nodiscard]] auto hit_rate() const -> double {
+      const auto lookups = hits + misses;
+      return lookups == 0 ? 0.0 : static_cast<double>(hits) / lookups;
+    }
+  };
+
+  /**
+   * @param budget Bytes held at most, split evenly between the shards: a
+   *        row's patterns and the bookkeeping of keeping it, which
+   *        FeedbackRows::entry_bytes counts. A row bigger than a shard's
+   *        share is never kept, nor one of a few candidates. 0 keeps nothing
+   */
+  explicit BasicFeedbackRows(std::size_t budget = std::size_t{4} << 20U);
+
+  BasicFeedbackRows(const BasicFeedbackRows &) = delete;
+  BasicFeedbackRows &operator=(const BasicFeedbackRows &) = delete;
+  BasicFeedbackRows(BasicFeedbackRows &&) = delete;
+  BasicFeedbackRows &operator=(BasicFeedbackRows &&) = delete;
+
+  /**
+   * @brief Count the patterns of `guess`, pattern table row `row`, against
+   *        `candidates` into `histogram`, computing the row on a miss
+   */
+  void count(const Candidates &candidates, std::uint32_t row,
+             PackedWord guess, PatternHistogram *histogram) const;
+
+  void clear();
+
+  [[nodiscard]] auto budget() const -> std::size_t { return _budget; }
+
+  [[nodiscard]] auto statistics() const -> Statistics;
+
+ private:
+  static constexpr std::size_t shard_count{16};
+
+  /// rows of fewer patterns take less time to compute than to look up
+  static constexpr std::size_t min_kept_row{
+      2 * BasicSolutionBlock<N, Alphabet>::lane_count};
+
+  /// a candidate set and a row of it
+  struct Key {
+    GuessCache::Key candidates;
+    std::uint32_t row{};
+
+    friend auto operator==(const Key &lhs, const Key &rhs) -> bool {
+      return lhs.candidates == rhs.candidates && lhs.row == rhs.row;
+    }
+  };
+
+  struct KeyHash {
+    auto operator()(const Key &key) const -> std::size_t {
+      return static_cast<std::size_t>(key.candidates.first ^
+                                      key.row * 0x9e3779b97f4a7c15);
+    }
+  };
+
+  /// shared, so a hit counts the row after letting go of the shard
+  using Row = std::shared_ptr<const std::vector<Pattern>>;
+
+  struct Shard {
+    std::mutex mutex;
+    /// most recently used first
+    std::list<std::pair<Key, Row>> entries;
+    std::unordered_map<Key, typename decltype(entries)::iterator, KeyHash>
+        index;
+    std::size_t bytes{};
+  };
+
+  /**
+   * @brief Bytes a row of `patterns` patterns takes when kept
+   * @details The patterns, the shared vector with its control block, the
+   *          list node, the index node and its bucket: four allocations,
+   *          each with a malloc header
+   */
+  static constexpr auto entry_bytes(const std::size_t patterns)
+      -> std::size_t {
+    constexpr std::size_t shared{sizeof(std::vector<Pattern>) +
+                                 2 * sizeof(void *)};
+    constexpr std::size_t list_node{sizeof(std::pair<Key, Row>) +
+                                    2 * sizeof(void *)};
+    constexpr std::size_t index_node{sizeof(std::pair<const Key, void *>) +
+                                     2 * sizeof(void *)};
+    constexpr std::size_t bucket{sizeof(void *)};
+    constexpr std::size_t allocation{2 * sizeof(void *)};
+    return patterns * sizeof(Pattern) + shared + list_node + index_node +
+           bucket + 4 * allocation;
+  }
+
+  std::size_t _budget;
+  std::size_t _shard_budget; ///< bytes each shard holds at most
+  mutable std::array<Shard, shard_count> _shards;
+
+  mutable std::atomic<std::uint64_t> _hits{};
+  mutable std::atomic<std::uint64_t> _misses{};
+  mutable std::atomic<std::uint64_t> _evictions{};
+};
+
+/// rows of five-letter feedback
+using FeedbackRows = BasicFeedbackRows<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_FEEDBACK_ROWS_HPP_
@@ -0,0 +1,104 @@
+#ifndef WORDLE_SOLVER_INCLUDE_GUESS_CACHE_HPP_
+#define WORDLE_SOLVER_INCLUDE_GUESS_CACHE_HPP_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class GuessCache
+ * @brief The best guesses for candidate sets already searched, shared by
+ *        solvers
+ * @details Different feedback often leaves the same candidates, and a
+ *          solver's guess depends only on them and its settings. Entries are
+ *          keyed by two independent 64-bit hashes of both, so collisions
+ *          don't matter, and hold the guess as a pattern table row. The
+ *          cache is split into shards, each behind its own mutex and
+ *          evicting its least recently used entry when full, so solvers on
+ *          many threads rarely wait for each other.
+ */
+class GuessCache {
+ public:
+  /// two independent hashes of a candidate set and the settings
+  struct Key {
+    std::uint64_t first{};
+    std::uint64_t second{};
+
+    friend auto operator==(const Key &lhs, const Key &rhs) -> bool {
+      return lhs.first == rhs.first && lhs.second == rhs.second;
+    }
+  };
+
+  struct Statistics {
+    std::uint64_t hits{};
+    std::uint64_t misses{};
+    std::uint64_t insertions{};
+    std::uint64_t evictions{};
+    std::size_t size{}; ///< entries held now
+  };
+
+  /**
+   * @param capacity Entries held at most, rounded up to a multiple of the
+   *        shards; each takes about 100 bytes
+   * @throws std::invalid_argument if `capacity` is 0
+   */
+  explicit GuessCache(std::size_t capacity = 1U << 16U);
+
+  GuessCache(const GuessCache &) = delete;
+  GuessCache &operator=(const GuessCache &) = delete;
+  GuessCache(GuessCache &&) = delete;
+  GuessCache &operator=(GuessCache &&) = delete;
+
+  /**
+   * @param settings Everything besides the candidates the guess depends on,
+   *        hashed by the caller, e.g. the dictionary's fingerprint and mode
+   * @param candidates The solutions still possible
+   */
+  [[nodiscard]] static auto key(std::uint64_t settings,
+                                const std::vector<std::uint32_t> &candidates)
+      -> Key;
+
+  /// the guess's pattern table row, counted as a hit or a miss
+  [[nodiscard]] auto find(const Key &key) -> std::optional<std::uint32_t>;
+
+  /// remember `row` for `key`, evicting the least recently used if full
+  void insert(const Key &key, std::uint32_t row);
+
+  void clear();
+
+  [[nodiscard]] auto capacity() const -> std::size_t { return _capacity; }
+
+  [[nodiscard]] auto statistics() const -> Statistics;
+
+ private:
+  static constexpr std::size_t shard_count{16};
+
+  struct KeyHash {
+    auto operator()(const Key &key) const -> std::size_t {
+      return static_cast<std::size_t>(key.first);
+    }
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    /// most recently used first
+    std::list<std::pair<Key, std::uint32_t>> entries;
+    std::unordered_map<Key, decltype(entries)::iterator, KeyHash> index;
+  };
+
+  std::size_t _capacity;
+  std::size_t _shard_capacity; ///< entries each shard holds at most
+  mutable std::array<Shard, shard_count> _shards;
+
+  std::atomic<std::uint64_t> _hits{};
+  std::atomic<std::uint64_t> _misses{};
+  std::atomic<std::uint64_t> _insertions{};
+  std::atomic<std::uint64_t> _evictions{};
+};
+
+#endif // WORDLE_SOLVER_INCLUDE_GUESS_CACHE_HPP_
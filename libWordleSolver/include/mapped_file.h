@@ -0,0 +1,36 @@
+#ifndef WORDLE_SOLVER_INCLUDE_MAPPED_FILE_HPP_
+#define WORDLE_SOLVER_INCLUDE_MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class MappedFile
+ * @brief A read-only file mapped into memory
+ * @details Pages are loaded on first access and shared with every other
+ *          process mapping the same file. Where mmap isn't available the
+ *          file is read into memory instead.
+ */
+class MappedFile {
+ public:
+  /// @throws std::runtime_error if the file can't be opened or mapped
+  explicit MappedFile(const std::string &file_name);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+  MappedFile(MappedFile &&) = delete;
+  MappedFile &operator=(MappedFile &&) = delete;
+
+  /// the first byte of the file, page-aligned when mapped
+  [[nodiscard]] auto data() const -> const std::byte * { return _data; }
+  [[nodiscard]] auto size() const -> std::size_t { return _size; }
+
+ private:
+  const std::byte *_data{};
+  std::size_t _size{};
+  std::vector<std::byte> _buffer; ///< the file, if it couldn't be mapped
+};
+
+#endif // WORDLE_SOLVER_INCLUDE_MAPPED_FILE_HPP_
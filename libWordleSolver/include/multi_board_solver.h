@@ -0,0 +1,125 @@
+#ifndef WORDLE_SOLVER_INCLUDE_MULTI_BOARD_SOLVER_HPP_
+#define WORDLE_SOLVER_INCLUDE_MULTI_BOARD_SOLVER_HPP_
+
+#include "constraints.h"
+#include "pattern_histogram.h"
+#include "word_list.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+template <int N, typename Alphabet> class BasicDictionary;
+class ThreadPool;
+
+/**
+ * @class BasicMultiBoardSolver
+ * @brief Solve several puzzles at once with the same guesses, as in Quordle
+ *        (4 boards) or Octordle (8 boards)
+ * @details Each board keeps its own constraints and candidates; the
+ *          dictionary and its pattern table are shared by all of them, and
+ *          with any other solver using it, so a board costs only its list of
+ *          candidates. A guess is scored by the sum of its entropies over the
+ *          unsolved boards, and any board down to one candidate is solved
+ *          first.
+ */
+template <int N, typename Alphabet = Latin> class BasicMultiBoardSolver {
+ public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+  using WordList = BasicWordList<N, Alphabet>;
+  using Feedback = BasicFeedback<N, Alphabet>;
+  using Constraints = BasicConstraints<N, Alphabet>;
+  using PatternHistogram = BasicPatternHistogram<Feedback>;
+  using Dictionary = BasicDictionary<N, Alphabet>;
+
+  /**
+   * @param dictionary The word lists to play with, shared with other solvers
+   * @param boards The number of hidden words, at least 1
+   * @throws std::invalid_argument for no boards, or a dictionary without a
+   *         pattern table
+   */
+  BasicMultiBoardSolver(std::shared_ptr<const Dictionary> dictionary,
+                        std::size_t boards);
+
+  /// start a new game with the same dictionary, boards and settings
+  void reset();
+
+  /// the next guess, played on every unsolved board
+  [[nodiscard]] auto guess() -> std::string;
+
+  /**
+   * @param feedback One "xygxx"-style string per board, in board order.
+   *        Entries for boards solved by earlier guesses are ignored
+   * @throws std::invalid_argument unless there is one string per board
+   */
+  void accept_feedback(const std::vector<std::string> &feedback);
+
+  [[nodiscard]] auto boards() const -> std::size_t { return _boards.size(); }
+
+  /// whether a guess has matched the word of `board`
+  [[nodiscard]] auto solved(const std::size_t board) const -> bool {
+    return _boards[board].solved;
+  }
+
+  /// whether every board is solved
+  [[nodiscard]] auto all_solved() const -> bool;
+
+  /// the words `board` can still hide, as indices into all_solutions
+  [[nodiscard]] auto candidates(const std::size_t board) const
+      -> const std::vector<std::uint32_t> & {
+    return _boards[board].candidates;
+  }
+
+  /// as WordleSolver::set_thread_count
+  void set_thread_count(unsigned thread_count);
+
+  /// as WordleSolver::set_thread_pool
+  void set_thread_pool(std::shared_ptr<ThreadPool> pool);
+
+  /// words the search didn't have to score, over the solver's lifetime
+  [[nodiscard]] auto skipped_evaluations() const -> std::uint64_t {
+    return _skipped_evaluations;
+  }
+
+ private:
+  struct Board {
+    Constraints constraints;
+    std::vector<std::uint32_t> candidates; ///< all_solutions indices
+    bool solved{};
+  };
+
+  /// unsolved boards with the same candidates, scored once
+  struct Group {
+    const std::vector<std::uint32_t> *candidates;
+    double weight; ///< the number of boards
+  };
+
+  [[nodiscard]] auto groups() const -> std::vector<Group>;
+
+  /**
+   * @brief Score rows in order of their summed EntropyBound, skipping those
+   *        whose bound is below the best score found so far by any thread
+   * @return The row with the highest summed entropy over the unsolved boards
+   */
+  [[nodiscard]] auto best_row() -> std::uint32_t;
+
+  /// the summed entropy of pattern table row `row` over `groups`
+  [[nodiscard]] auto get_score(std::uint32_t row,
+                               const std::vector<Group> &groups) const
+      -> double;
+
+  std::shared_ptr<const Dictionary> _dictionary;
+  std::shared_ptr<ThreadPool> _pool;
+  std::uint64_t _skipped_evaluations{};
+
+  std::vector<Board> _boards;
+  PackedWord _last_guess;
+  /// the first guess is chosen from every word, later ones from solutions
+  bool _first_turn{true};
+};
+
+/// the multi-board solver for five-letter words
+using MultiBoardSolver = BasicMultiBoardSolver<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_MULTI_BOARD_SOLVER_HPP_
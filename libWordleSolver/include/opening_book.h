@@ -0,0 +1,94 @@
+#ifndef WORDLE_SOLVER_INCLUDE_OPENING_BOOK_HPP_
+#define WORDLE_SOLVER_INCLUDE_OPENING_BOOK_HPP_
+
+#include "feedback.h"
+#include "packed_word.h"
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+template <int N, typename Alphabet> class BasicDictionary;
+
+/**
+ * @class BasicOpeningBook
+ * @brief Precomputed guesses for the first turns of a game
+ * @details The solver's guess depends only on the feedback it has received,
+ *          so the book maps each feedback history, up to a given depth, to the
+ *          guess WordleSolver would make. WordleSolver::guess consults it
+ *          before evaluating entropies.
+ */
+template <int N, typename Alphabet = Latin> class BasicOpeningBook {
+ public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+  using Feedback = BasicFeedback<N, Alphabet>;
+  using Dictionary = BasicDictionary<N, Alphabet>;
+
+  /// the feedback received so far, one pattern per guess
+  using History = std::vector<typename Feedback::Pattern>;
+
+  /// longest history a book can hold: 7, or fewer if the keys of longer
+  /// histories of longer words don't fit 64 bits
+  static constexpr int max_depth = [] {
+    constexpr std::uint64_t base = Feedback::pattern_count + 1;
+    int depth{};
+    std::uint64_t keys{1}; // base^depth
+    while (depth < 7 &&
+           keys <= std::numeric_limits<std::uint64_t>::max() / base) {
+      keys *= base;
+      ++depth;
+    }
+    return depth;
+  }();
+
+  /**
+   * @brief Play every reachable history up to `depth` turns and record the
+   *        solver's guesses
+   * @param dictionary The dictionary the book is for
+   * @param depth Turns covered, 1 being only the opening guess
+   * @throws std::invalid_argument for a depth out of range, or a dictionary
+   *         without a pattern table
+   */
+  [[nodiscard]] static auto build(std::shared_ptr<const Dictionary> dictionary,
+                                  int depth)
+      -> std::shared_ptr<const BasicOpeningBook>;
+
+  /**
+   * @brief Read a book written by OpeningBook::save
+   * @throws std::runtime_error if the file can't be read, isn't a book, or
+   *         was built for a different dictionary
+   */
+  [[nodiscard]] static auto load(const std::string &file_name,
+                                 const Dictionary &dictionary)
+      -> std::shared_ptr<const BasicOpeningBook>;
+
+  /// @throws std::runtime_error if the file can't be written
+  void save(const std::string &file_name) const;
+
+  /// the guess to make after `history`, if the book covers it
+  [[nodiscard]] auto find(const History &history) const
+      -> std::optional<PackedWord>;
+
+  [[nodiscard]] auto depth() const -> int { return _depth; }
+  [[nodiscard]] auto size() const -> std::size_t { return _entries.size(); }
+
+ private:
+  /// (history key, packed guess), sorted by key
+  using Entry = std::pair<std::uint64_t, typename PackedWord::Key>;
+
+  /// a unique number for every history of up to max_depth patterns
+  [[nodiscard]] static auto key(const History &history) -> std::uint64_t;
+
+  int _depth{};
+  std::uint64_t _fingerprint{};
+  std::vector<Entry> _entries;
+};
+
+/// the opening book of five-letter games
+using OpeningBook = BasicOpeningBook<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_OPENING_BOOK_HPP_
@@ -0,0 +1,153 @@
+#ifndef WORDLE_SOLVER_INCLUDE_PACKED_WORD_HPP_
+#define WORDLE_SOLVER_INCLUDE_PACKED_WORD_HPP_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @brief The letters words are made of: `Size` consecutive characters from
+ *        `First`
+ */
+template <char First, int Size> struct BasicAlphabet {
+  static_assert(Size >= 2 && Size <= 32, "letter masks have 32 bits");
+
+  static constexpr char first = First;
+  static constexpr int size = Size;
+};
+
+/// 'a' to 'z'
+using Latin = BasicAlphabet<'a', 26>;
+
+/**
+ * @class BasicPackedWord
+ * @brief An `N`-letter word in one or two integers and a letter mask
+ * @details The letters are stored as alphabet indices of
+ *          BasicPackedWord::letter_bits bits each in one integer, first
+ *          letter most significant, so packed words compare in alphabetical
+ *          order. A mask records which letters occur. Five Latin letters fit
+ *          in eight bytes, and seven or eight in sixteen.
+ */
+template <int N, typename Alphabet = Latin> class BasicPackedWord {
+ public:
+  /// letters per word
+  static constexpr int length = N;
+  /// letters in the alphabet, 'a' to 'z' for Latin
+  static constexpr int alphabet_size = Alphabet::size;
+  static constexpr int letter_bits = [] {
+    int bits{1};
+    while ((1 << bits) < Alphabet::size) {
+      ++bits;
+    }
+    return bits;
+  }();
+
+  static_assert(N >= 1 && N * letter_bits <= 64, "the letters fit a key");
+
+  /// the packed letters: 32 bits when they fit, 64 otherwise
+  using Key =
+      std::conditional_t<N * letter_bits <= 32, std::uint32_t, std::uint64_t>;
+
+  constexpr BasicPackedWord() = default;
+
+  /// @param word `length` letters of the alphabet, unchecked: see parse
+  explicit constexpr BasicPackedWord(const std::string_view word) {
+    for (int i = 0; i < length; ++i) {
+      const auto index = static_cast<std::uint32_t>(word[i] - Alphabet::first);
+      _letters = (_letters << letter_bits) | index;
+      _mask |= 1U << index;
+    }
+  }
+
+  /**
+   * @brief `word` packed, for words from outside the program
+   * @throws std::invalid_argument unless `word` is `length` letters of the
+   *         alphabet
+   */
+  [[nodiscard]] static auto parse(const std::string_view word)
+      -> BasicPackedWord {
+    if (word.size() != static_cast<std::size_t>(length)) {
+      throw std::invalid_argument("'" + std::string{word} + "' is not " +
+                                  std::to_string(length) + " letters long");
+    }
+    for (const char ch : word) {
+      if (ch < Alphabet::first || ch >= Alphabet::first + Alphabet::size) {
+        throw std::invalid_argument(
+            "'" + std::string{word} + "' has a letter outside " +
+            Alphabet::first + " to " +
+            static_cast<char>(Alphabet::first + Alphabet::size - 1));
+      }
+    }
+    return BasicPackedWord{word};
+  }
+
+  /// the word with packed letters `key`, as returned by BasicPackedWord::key
+  [[nodiscard]] static constexpr auto from_key(const Key key)
+      -> BasicPackedWord {
+    BasicPackedWord word;
+    word._letters = key;
+    for (int i = 0; i < length; ++i) {
+      word._mask |= 1U << word.letter(i);
+    }
+    return word;
+  }
+
+  /// alphabet index, 0 to alphabet_size - 1, of the letter at `position`
+  [[nodiscard]] constexpr auto letter(const int position) const -> int {
+    const auto shift = (length - 1 - position) * letter_bits;
+    return static_cast<int>((_letters >> shift) & letter_mask);
+  }
+
+  /// the character at `position`
+  [[nodiscard]] constexpr auto at(const int position) const -> char {
+    return static_cast<char>(Alphabet::first + letter(position));
+  }
+
+  /// bit i is set if letter i of the alphabet occurs in the word
+  [[nodiscard]] constexpr auto mask() const -> std::uint32_t {
+    return static_cast<std::uint32_t>(_mask);
+  }
+
+  [[nodiscard]] constexpr auto contains(const char ch) const -> bool {
+    return ((_mask >> (ch - Alphabet::first)) & 1U) != 0;
+  }
+
+  /// the packed letters, usable as a sort or hash key
+  [[nodiscard]] constexpr auto key() const -> Key { return _letters; }
+
+  [[nodiscard]] auto to_string() const -> std::string {
+    std::string word(length, ' ');
+    for (int i = 0; i < length; ++i) {
+      word[i] = at(i);
+    }
+    return word;
+  }
+
+  friend constexpr auto operator==(const BasicPackedWord lhs,
+                                   const BasicPackedWord rhs) -> bool {
+    return lhs._letters == rhs._letters;
+  }
+  friend constexpr auto operator!=(const BasicPackedWord lhs,
+                                   const BasicPackedWord rhs) -> bool {
+    return lhs._letters != rhs._letters;
+  }
+  friend constexpr auto operator<(const BasicPackedWord lhs,
+                                  const BasicPackedWord rhs) -> bool {
+    return lhs._letters < rhs._letters;
+  }
+
+ private:
+  static constexpr Key letter_mask = (Key{1} << letter_bits) - 1;
+
+  Key _letters{};
+  /// as wide as the key, so a word has no padding bytes: Dictionary::save
+  /// writes words as they are in memory
+  Key _mask{};
+};
+
+/// the five-letter words of the original game
+using PackedWord = BasicPackedWord<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_PACKED_WORD_HPP_
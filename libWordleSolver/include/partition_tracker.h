@@ -0,0 +1,116 @@
+#ifndef WORDLE_SOLVER_INCLUDE_PARTITION_TRACKER_HPP_
+#define WORDLE_SOLVER_INCLUDE_PARTITION_TRACKER_HPP_
+
+#include "pattern_table.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class BasicPartitionTracker
+ * @brief Keeps the pattern counts of every solution row it scores from turn
+ *        to turn, so a row scored again is brought up to date by taking out
+ *        the candidates eliminated since
+ * @details Candidates are only ever eliminated, so a row's counts of an
+ *          earlier turn are the new candidates' plus those eliminated since.
+ *          A row is updated when fewer candidates were eliminated than a
+ *          fresh count would cost, clearing the counts included, and
+ *          recounted otherwise. Each row also keeps the sum of
+ *          Entropy::n_log2_n_fixed over its counts, changed by one term per
+ *          candidate counted or taken out, so neither way passes over every
+ *          pattern, and both give the entropy Entropy::entropy does to the
+ *          last bit. Threads may score different rows at once, but not while
+ *          the tracker advances a turn.
+ */
+template <int N, typename Alphabet = Latin> class BasicPartitionTracker {
+ public:
+  using PatternTable = BasicPatternTable<N, Alphabet>;
+  using Feedback = typename PatternTable::Feedback;
+  using Pattern = typename Feedback::Pattern;
+
+  /// how the tracker's scores were found, over its lifetime
+  struct Statistics {
+    std::uint64_t updates{};  ///< from a row's counts of an earlier turn
+    std::uint64_t recounts{}; ///< counted afresh
+  };
+
+  /// whether the table's solutions fit the tracker's 16-bit counts
+  [[nodiscard]] static auto supports(const PatternTable &patterns) -> bool;
+
+  /**
+   * @param patterns The dictionary's pattern table, which must outlive the
+   *        tracker and pass supports()
+   * @note  Reserves room for the counts of every solution row, 2 bytes a
+   *        pattern; the memory is only touched for the rows scored
+   */
+  explicit BasicPartitionTracker(const PatternTable &patterns);
+
+  /// start a turn whose candidates are the last one's but `removed`
+  void advance(const std::vector<std::uint32_t> &removed);
+
+  /// forget every row's counts, for candidates that aren't the last turn's
+  void clear();
+
+  /**
+   * @param row A solution's row of the pattern table
+   * @param candidates The solutions still possible this turn, as columns
+   * @return The entropy of `row` over `candidates`
+   */
+  [[nodiscard]] auto entropy(std::uint32_t row,
+                             const std::vector<std::uint32_t> &candidates)
+      -> double;
+
+  /// whether `row` is a solution's, which are the rows tracked
+  [[nodiscard]] auto tracks(const std::uint32_t row) const -> bool {
+    return row < _slots.size() && _slots[row] != untracked;
+  }
+
+  [[nodiscard]] auto statistics() const -> Statistics {
+    return {_updates.load(), _recounts.load()};
+  }
+
+ private:
+  static constexpr std::uint32_t untracked{~std::uint32_t{}};
+  static constexpr std::uint32_t unassigned{untracked - 1};
+
+  /**
+   * @brief What clearing a row's counts costs, in candidates taken out
+   * @details Clearing goes many bytes at a time and taking a candidate out
+   *          one count; a sixteenth of the bytes was as quick as anything
+   *          tried on six- to eight-letter words
+   */
+  static constexpr std::size_t clear_cost{Feedback::pattern_count *
+                                          sizeof(std::uint16_t) / 16};
+
+  const PatternTable &_patterns;
+  /// the slot of every row; unassigned until the row is first scored, and
+  /// untracked for a row that isn't a solution's
+  std::vector<std::uint32_t> _slots;
+  /// slots go to rows in the order they are first scored, so a game keeps
+  /// its counts together, in memory the last game has touched
+  std::atomic<std::uint32_t> _next_slot{};
+  /// the row of each slot given out
+  std::vector<std::uint32_t> _rows;
+  /// the counts of each slot, Feedback::pattern_count apiece
+  std::unique_ptr<std::uint16_t[]> _counts;
+  /// the n_log2_n_fixed sum of each slot's counts
+  std::vector<std::int64_t> _sums;
+  /// the turn each slot was last counted at
+  std::vector<std::uint32_t> _turns;
+
+  /// the candidates eliminated after every turn, oldest first
+  std::vector<std::uint32_t> _removed;
+  /// where in _removed each turn's eliminations start; the last entry is
+  /// _removed's size, and the current turn is the number of turns before it
+  std::vector<std::size_t> _starts{0};
+
+  std::atomic<std::uint64_t> _updates{};
+  std::atomic<std::uint64_t> _recounts{};
+};
+
+/// the tracker of five-letter games
+using PartitionTracker = BasicPartitionTracker<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_PARTITION_TRACKER_HPP_
@@ -0,0 +1,65 @@
+#ifndef WORDLE_SOLVER_INCLUDE_PATTERN_HISTOGRAM_HPP_
+#define WORDLE_SOLVER_INCLUDE_PATTERN_HISTOGRAM_HPP_
+
+#include "entropy.h"
+#include "feedback.h"
+
+#include <array>
+#include <cstdint>
+#include <iterator>
+
+/**
+ * @class BasicPatternHistogram
+ * @brief Counts how many solutions give each feedback pattern for one guess
+ * @details A fixed array with one bucket per Feedback::Pattern, meant to live
+ *          on the stack of the entropy loop: counting is a single increment
+ *          per solution and nothing is allocated.
+ * @tparam  Feedback The BasicFeedback of the word length, which sets the
+ *          number of buckets
+ */
+template <typename Feedback> class BasicPatternHistogram {
+ public:
+  using Pattern = typename Feedback::Pattern;
+  using Count = std::uint32_t;
+  using Counts = std::array<Count, Feedback::pattern_count>;
+
+  /**
+   * @brief Count the patterns of one pattern table row
+   * @param row The patterns of a guess against every solution
+   * @param first,last The columns (solutions) to count
+   */
+  template <typename It> void count(const Pattern *row, It first,
+                                    It last) {
+    _total += static_cast<Count>(std::distance(first, last));
+    for (; first != last; ++first) {
+      ++_counts[row[*first]];
+    }
+  }
+
+  void add(const Pattern pattern) {
+    ++_counts[pattern];
+    ++_total;
+  }
+
+  void clear() {
+    _counts.fill(0);
+    _total = 0;
+  }
+
+  [[nodiscard]] auto counts() const -> const Counts & { return _counts; }
+  [[nodiscard]] auto total() const -> Count { return _total; }
+
+  /// the expected information, in bits, of the counted guess
+  [[nodiscard]] auto entropy() const -> double {
+    return Entropy::entropy(_counts, _total);
+  }
+
+ private:
+  Counts _counts{};
+  Count _total{};
+};
+
+/// a histogram of five-letter patterns
+using PatternHistogram = BasicPatternHistogram<Feedback>;
+
+#endif // WORDLE_SOLVER_INCLUDE_PATTERN_HISTOGRAM_HPP_
@@ -0,0 +1,106 @@
+#ifndef WORDLE_SOLVER_INCLUDE_PATTERN_TABLE_HPP_
+#define WORDLE_SOLVER_INCLUDE_PATTERN_TABLE_HPP_
+
+#include "feedback.h"
+#include "feedback_batch.h"
+#include "word_list.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @class BasicPatternTable
+ * @brief Dense guess x solution table of feedback patterns
+ * @details Every row holds the Feedback::Pattern of one guess word against
+ *          every solution word, one byte per entry. The table is built once,
+ *          in parallel with FeedbackBatch, and is immutable afterwards; a
+ *          Dictionary owns one and shares it with all its solvers.
+ */
+template <int N, typename Alphabet = Latin> class BasicPatternTable {
+ public:
+  using WordList = BasicWordList<N, Alphabet>;
+  using Feedback = BasicFeedback<N, Alphabet>;
+  using Pattern = typename Feedback::Pattern;
+
+  /**
+   * @param guesses The guess words, one row each, in order
+   * @param solutions The solution words, one column each, in order
+   * @param fill Compute the patterns; without them the table only numbers
+   *        the rows, and FeedbackRows computes them on demand
+   * @note  Solutions that are missing from the guesses are appended as extra
+   *        rows, so every solution can also be looked up as a guess.
+   */
+  BasicPatternTable(const WordList &guesses, const WordList &solutions,
+                    bool fill = true);
+
+  /**
+   * @brief Use a table built earlier, e.g. held in a memory-mapped file,
+   *        without copying it
+   * @param guesses The words of the rows, appended solutions included
+   * @param solution_rows Row of every solution, by column
+   * @param patterns guesses.size() x solutions.size() patterns, row-major
+   * @param owner Keeps `patterns` alive for as long as the table
+   */
+  BasicPatternTable(WordList guesses, WordList solutions,
+                    std::vector<std::uint32_t> solution_rows,
+                    const Pattern *patterns,
+                    std::shared_ptr<const void> owner);
+
+  [[nodiscard]] auto pattern(const std::size_t guess,
+                             const std::size_t solution) const -> Pattern {
+    return data()[guess * _solutions.size() + solution];
+  }
+
+  /// the patterns of one guess against every solution
+  [[nodiscard]] auto row(const std::size_t guess) const -> const Pattern * {
+    return data() + guess * _solutions.size();
+  }
+
+  /// the whole table, row-major
+  [[nodiscard]] auto data() const -> const Pattern * {
+    return _view != nullptr ? _view : _patterns.data();
+  }
+
+  /// whether the table holds patterns; pattern(), row() and data() need them
+  [[nodiscard]] auto filled() const -> bool { return _filled; }
+
+  [[nodiscard]] auto guess_count() const -> std::size_t {
+    return _guesses.size();
+  }
+  [[nodiscard]] auto solution_count() const -> std::size_t {
+    return _solutions.size();
+  }
+
+  /// the words of the rows, including appended solutions
+  [[nodiscard]] auto guesses() const -> const WordList & { return _guesses; }
+  [[nodiscard]] auto solutions() const -> const WordList & {
+    return _solutions;
+  }
+
+  /// row of every solution, by column
+  [[nodiscard]] auto solution_rows() const
+      -> const std::vector<std::uint32_t> & {
+    return _solution_rows;
+  }
+
+ private:
+  /// fill rows [first, last) of the table
+  void fill_rows(const BasicSolutionBlock<N, Alphabet> &block,
+                 std::size_t first, std::size_t last);
+
+  WordList _guesses;
+  WordList _solutions;
+  std::vector<std::uint32_t> _solution_rows;
+
+  std::vector<Pattern> _patterns; ///< row-major, guesses x solutions
+  bool _filled{true};
+
+  const Pattern *_view{}; ///< the table, if it is held elsewhere
+  std::shared_ptr<const void> _owner; ///< keeps _view alive
+};
+
+/// the pattern table of five-letter words
+using PatternTable = BasicPatternTable<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_PATTERN_TABLE_HPP_
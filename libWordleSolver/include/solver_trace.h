@@ -0,0 +1,64 @@
+#ifndef WORDLE_SOLVER_INCLUDE_SOLVER_TRACE_HPP_
+#define WORDLE_SOLVER_INCLUDE_SOLVER_TRACE_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @struct TurnTrace
+ * @brief Where the time of one turn went: a guess and the feedback to it
+ * @details Recorded by WordleSolver::set_tracing. Phases that didn't run in
+ *          the turn, such as the search when the guess came from an opening
+ *          book, keep a zero duration.
+ */
+struct TurnTrace {
+  using Clock = std::chrono::steady_clock;
+
+  struct Phase {
+    Clock::time_point start{};
+    Clock::duration duration{};
+  };
+
+  /// a chunk of the words scored, as claimed by one thread of the pool
+  struct Chunk {
+    std::thread::id thread;
+    Clock::time_point start{};
+    Clock::duration duration{};
+    std::uint32_t words{}; ///< words scored; the bounds may skip the rest
+  };
+
+  std::string guess;
+  std::thread::id thread; ///< the thread that called guess
+
+  Phase guess_phase;      ///< all of WordleSolver::guess
+  Phase select_wordlist;  ///< choosing the words worth scoring
+  Phase eval_entropies;   ///< the cache lookup and the search
+  Phase update_internals; ///< adding the feedback to the constraints
+  Phase prune_guess_list; ///< removing the candidates it rules out
+
+  std::size_t candidates_before{}; ///< solutions possible at the guess
+  std::size_t candidates_after{};  ///< and after the feedback to it
+  std::uint64_t evaluations{};     ///< entropies computed
+  std::uint64_t skipped{};         ///< words the bounds didn't score
+  bool cache_hit{};                ///< the guess came from the GuessCache
+
+  /// every chunk of the search, for spotting threads left idle
+  std::vector<Chunk> chunks;
+};
+
+/**
+ * @brief Write `turns` as Chrome trace events, for chrome://tracing or
+ *        Perfetto
+ * @details Each turn and phase is a complete event on the thread that ran
+ *          it, and each chunk one on the pool thread that claimed it. A
+ *          turn runs until its feedback is pruned, so it includes the wait
+ *          for the feedback. Times count from the first turn's start.
+ */
+void write_chrome_trace(std::ostream &out,
+                        const std::vector<TurnTrace> &turns);
+
+#endif // WORDLE_SOLVER_INCLUDE_SOLVER_TRACE_HPP_
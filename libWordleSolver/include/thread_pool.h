@@ -0,0 +1,158 @@
+#ifndef WORDLE_SOLVER_INCLUDE_THREAD_POOL_HPP_
+#define WORDLE_SOLVER_INCLUDE_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Persistent work-stealing thread pool
+ * @details Each worker has its own task deque: it pops its own tasks from
+ *          the back and steals from the front of the others' when it runs
+ *          dry. Loops are split into small chunks that runners claim one at a
+ *          time, so uneven chunk costs balance out, and the calling thread
+ *          runs chunks too instead of blocking.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @param thread_count Threads working on a loop, counting the caller, so
+   *        thread_count - 1 workers are started. 0 means one per core.
+   */
+  explicit ThreadPool(unsigned thread_count = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ThreadPool(ThreadPool &&) = delete;
+  ThreadPool &operator=(ThreadPool &&) = delete;
+
+  /// a pool with one thread per core, created on first use
+  [[nodiscard]] static auto shared() -> std::shared_ptr<ThreadPool>;
+
+  /// threads working on a loop, including the caller
+  [[nodiscard]] auto thread_count() const -> unsigned {
+    return static_cast<unsigned>(_workers.size()) + 1;
+  }
+
+  /// queue a task; it runs on some worker, or on the caller if there is none
+  void submit(std::function<void()> task);
+
+  /**
+   * @brief Reduce over [0, count) in chunks of `grain` indices
+   * @details Every runner keeps its own result, starting from `identity`,
+   *          calls `body(begin, end, result)` for each chunk it claims and
+   *          merges its result into the total once, at the end.
+   * @param merge Must be associative and commutative, e.g. a max
+   * @return The merged result of all runners
+   */
+  template <typename T, typename Body, typename Merge>
+  auto parallel_reduce(std::size_t count, std::size_t grain, T identity,
+                       Body body, Merge merge) -> T;
+
+  /// call `body(begin, end)` for chunks of [0, count)
+  template <typename Body>
+  void parallel_for(std::size_t count, std::size_t grain, Body body);
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void run_worker(std::size_t index);
+
+  /// pop a task from worker `index`, or steal one from another worker
+  auto take_task(std::size_t index, std::function<void()> *task) -> bool;
+
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::vector<std::thread> _threads;
+
+  std::mutex _sleep_mutex;
+  std::condition_variable _wake;
+  std::size_t _pending{}; ///< queued tasks, guarded by _sleep_mutex
+  bool _stopping{};
+
+  std::atomic<std::size_t> _next_worker{};
+};
+
+template <typename T, typename Body, typename Merge>
+auto ThreadPool::parallel_reduce(const std::size_t count,
+                                 const std::size_t grain, T identity,
+                                 Body body, Merge merge) -> T {
+  const auto chunk_size = std::max<std::size_t>(1, grain);
+  const auto chunk_count = (count + chunk_size - 1) / chunk_size;
+
+  // Runners may only start once every chunk has been taken, possibly after
+  // this call has returned, so they check for work under the group lock
+  // before touching anything on this stack frame.
+  struct Group {
+    std::atomic<std::size_t> next_chunk{};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t active{};
+    std::size_t completed{};
+  };
+  const auto group = std::make_shared<Group>();
+  T total = identity;
+
+  const auto run = [group, chunk_size, chunk_count, count, &identity, &body,
+                    &merge, &total] {
+    {
+      const std::lock_guard lock(group->mutex);
+      if (group->next_chunk.load() >= chunk_count) {
+        return;
+      }
+      ++group->active;
+    }
+    T local = identity;
+    std::size_t processed{};
+    for (auto chunk = group->next_chunk++; chunk < chunk_count;
+         chunk = group->next_chunk++) {
+      const auto begin = chunk * chunk_size;
+      body(begin, std::min(count, begin + chunk_size), local);
+      ++processed;
+    }
+    const std::lock_guard lock(group->mutex);
+    if (processed != 0) {
+      total = merge(total, local);
+      group->completed += processed;
+    }
+    --group->active;
+    group->done.notify_all();
+  };
+
+  const auto helpers = std::min<std::size_t>(
+      _workers.size(), chunk_count == 0 ? 0 : chunk_count - 1);
+  for (std::size_t i = 0; i < helpers; ++i) {
+    submit(run);
+  }
+  run();
+
+  std::unique_lock lock(group->mutex);
+  group->done.wait(lock, [&group, chunk_count] {
+    return group->completed == chunk_count && group->active == 0;
+  });
+  return total;
+}
+
+template <typename Body>
+void ThreadPool::parallel_for(const std::size_t count, const std::size_t grain,
+                              Body body) {
+  struct Nothing {};
+  parallel_reduce(
+      count, grain, Nothing{},
+      [&body](const std::size_t begin, const std::size_t end, Nothing &) {
+        body(begin, end);
+      },
+      [](Nothing, Nothing) { return Nothing{}; });
+}
+
+#endif // WORDLE_SOLVER_INCLUDE_THREAD_POOL_HPP_
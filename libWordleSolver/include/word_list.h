@@ -0,0 +1,80 @@
+#ifndef WORDLE_SOLVER_INCLUDE_WORD_LIST_HPP_
+#define WORDLE_SOLVER_INCLUDE_WORD_LIST_HPP_
+
+#include "packed_word.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class BasicWordList
+ * @brief A contiguous list of packed words
+ * @details Text is only used to build the list and to read words back out;
+ *          the solver works with PackedWord values and their indices. A list
+ *          either owns its words or views words held elsewhere, e.g. in a
+ *          memory-mapped file; copying a view doesn't copy the words.
+ */
+template <int N, typename Alphabet = Latin> class BasicWordList {
+ public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+
+  /// returned by WordList::index_of when a word is not in the list
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  BasicWordList() = default;
+  /// @throws std::invalid_argument for a word not `N` letters of the alphabet
+  explicit BasicWordList(const std::vector<std::string> &words);
+
+  /**
+   * @brief A list of `count` words at `words`, without copying them
+   * @param owner Keeps the words alive for as long as the list and its copies
+   */
+  [[nodiscard]] static auto view(const PackedWord *words, std::size_t count,
+                                 std::shared_ptr<const void> owner)
+      -> BasicWordList;
+
+  [[nodiscard]] auto size() const -> std::size_t {
+    return _view != nullptr ? _view_size : _words.size();
+  }
+  [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+  [[nodiscard]] auto operator[](const std::size_t index) const -> PackedWord {
+    return data()[index];
+  }
+  [[nodiscard]] auto data() const -> const PackedWord * {
+    return _view != nullptr ? _view : _words.data();
+  }
+  [[nodiscard]] auto begin() const -> const PackedWord * { return data(); }
+  [[nodiscard]] auto end() const -> const PackedWord * {
+    return data() + size();
+  }
+
+  /// @note A view copies its words into the list first
+  void push_back(PackedWord word);
+
+  /// position of `word`, or WordList::npos
+  [[nodiscard]] auto index_of(PackedWord word) const -> std::size_t;
+
+  [[nodiscard]] auto to_strings() const -> std::vector<std::string>;
+
+  friend auto operator==(const BasicWordList &lhs, const BasicWordList &rhs)
+      -> bool {
+    return lhs.size() == rhs.size() &&
+           std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+ private:
+  std::vector<PackedWord> _words;
+  bool _sorted{true}; ///< lets index_of use a binary search
+
+  const PackedWord *_view{}; ///< the words, if the list is a view
+  std::size_t _view_size{};
+  std::shared_ptr<const void> _owner; ///< keeps _view alive
+};
+
+/// a list of five-letter words
+using WordList = BasicWordList<5>;
+
+#endif // WORDLE_SOLVER_INCLUDE_WORD_LIST_HPP_
@@ -1,24 +1,82 @@
 #ifndef WORDLE_SOLVER_INCLUDE_WORDLE_SOLVER_HPP_
 #define WORDLE_SOLVER_INCLUDE_WORDLE_SOLVER_HPP_
 
+#include "cancellation_token.h"
+#include "constraints.h"
+#include "decision_tree.h"
+#include "feedback_rows.h"
+#include "guess_cache.h"
+#include "opening_book.h"
+#include "partition_tracker.h"
+#include "pattern_histogram.h"
+#include "solver_trace.h"
+#include "word_list.h"
+
+#include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <iomanip>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
+template <int N, typename Alphabet> class BasicDictionary;
+class ThreadPool;
+
 /**
- * @class WordleSolver
+ * @class BasicWordleSolver
  * @brief Solve a wordle puzzle using Shannon's entropy formula
+ * @details Every part of the solver is specialized at compile time for words
+ *          of `N` letters from `Alphabet`; the library is built for 4 to 8
+ *          Latin letters. WordleSolver plays the original five-letter game.
  */
-class WordleSolver {
+template <int N, typename Alphabet = Latin> class BasicWordleSolver {
  public:
+  using PackedWord = BasicPackedWord<N, Alphabet>;
+  using WordList = BasicWordList<N, Alphabet>;
+  using Feedback = BasicFeedback<N, Alphabet>;
+  using Constraints = BasicConstraints<N, Alphabet>;
+  using PatternHistogram = BasicPatternHistogram<Feedback>;
+  using Dictionary = BasicDictionary<N, Alphabet>;
+  using OpeningBook = BasicOpeningBook<N, Alphabet>;
+  using DecisionTree = BasicDecisionTree<N, Alphabet>;
+  using FeedbackRows = BasicFeedbackRows<N, Alphabet>;
+  using PartitionTracker = BasicPartitionTracker<N, Alphabet>;
+
   /**
    * @note  Requires text files as named below to be accessible. \n
    *        "all_words.txt" is the large word list of all valid guesses -- good
    *        for choosing high entropy words \n
    *        "all_solutions.txt" is the smaller list of words that are
-   *        possible solutions to the puzzle
+   *        possible solutions to the puzzle \n
+   *        They are loaded once, by Dictionary::shared_default, and shared by
+   *        every solver made this way.
    */
-  WordleSolver();
+  BasicWordleSolver();
+
+  /// where a solver gets its dictionary when it isn't given one
+  enum class WordLists {
+    files,    ///< read from "word_lists/", as by the default constructor
+    embedded, ///< compiled into the library; needs no files at all
+  };
+
+  /**
+   * @param word_lists Use the shared dictionary from Dictionary::shared_default
+   *        or the one from Dictionary::embedded
+   */
+  explicit BasicWordleSolver(WordLists word_lists);
+
+  /**
+   * @param dictionary The word lists to play with, shared with other solvers
+   * @note  Only per-game state is created, so this is cheap. A dictionary of
+   *        Storage::on_demand gives the solver FeedbackRows of its own
+   */
+  explicit BasicWordleSolver(std::shared_ptr<const Dictionary> dictionary);
+
+  /// start a new game with the same dictionary and settings
+  void reset();
 
   /**
    * @brief   Give the next guess
@@ -26,6 +84,31 @@ class WordleSolver {
    */
   [[nodiscard]] auto guess() -> std::string;
 
+  using Clock = std::chrono::steady_clock;
+
+  /// a guess from WordleSolver::guess(deadline), and how far its search got
+  struct AnytimeGuess {
+    std::string word;
+    std::size_t words{};   ///< words the search had to consider
+    std::size_t covered{}; ///< of those, scored or ruled out by their bound
+    bool complete{};       ///< all were covered: the guess guess() makes
+                           ///< without a lookahead
+  };
+
+  /**
+   * @brief   Give the best guess found by `deadline`, or by the time
+   *          `cancel` is cancelled from another thread
+   * @details Words are scored in the order of their EntropyBound, a letter
+   *          frequency estimate, so the most promising come first, and the
+   *          best so far is shared by the threads. At least one word is
+   *          scored whatever the deadline. Incomplete searches aren't added
+   *          to the GuessCache. The lookahead is off for these guesses
+   * @param   cancel Polled between words, or nullptr
+   */
+  [[nodiscard]] auto guess(Clock::time_point deadline,
+                           const CancellationToken *cancel = nullptr)
+      -> AnytimeGuess;
+
   /**
    * @brief   Read feedback into _feedback from std::cin
    * @details 'x' - gray \n
@@ -37,19 +120,159 @@ class WordleSolver {
   /**
    * @brief   Apparently, huge static variables cause compilation to eat ALL THE
    *          RAM. So, text files it is.
-   * @param   file_name The word list to load
+   * @note    Dictionary::embedded compiles the lists in as packed integers
+   *          instead, which is cheap for the compiler
+   * @param   file_name The word list to load, a word per line; blank lines
+   *          and the '\r' of Windows line endings are skipped
    * @return  The words in the list
+   * @throws  std::invalid_argument, naming the line, for one that isn't
+   *          `N` letters of the alphabet
    */
   [[nodiscard]] static auto load_wordlist(std::string_view file_name)
       -> std::vector<std::string>;
 
+  /// WordleSolver::load_wordlist for a list held in memory
   [[nodiscard]] static auto load_wordlist(const char *characters,
                                           unsigned int length)
       -> std::vector<std::string>;
 
-  static constexpr int word_len = 5;
+  /**
+   * @brief   Set how many threads evaluate entropies, counting the caller
+   * @details Gives the solver a pool of its own; 1 keeps all the work on the
+   *          thread calling WordleSolver::guess
+   */
+  void set_thread_count(unsigned thread_count);
+
+  /**
+   * @brief   Evaluate entropies on `pool`, which may be shared with other
+   *          solvers. By default every solver uses ThreadPool::shared()
+   */
+  void set_thread_pool(std::shared_ptr<ThreadPool> pool);
+
+  /// threads evaluating entropies, counting the caller
+  [[nodiscard]] auto thread_count() const -> unsigned;
+
+  /// how the best guess is found; both find the same one
+  enum class Search {
+    exhaustive,       ///< score every word
+    branch_and_bound, ///< skip words whose EntropyBound can't beat the best
+  };
+
+  /// branch_and_bound unless set otherwise
+  void set_search(Search search);
+
+  /**
+   * @brief   Play by the hard mode rule: every guess keeps the green letters
+   *          in place and uses every letter revealed so far
+   * @details Guesses from the opening book or decision tree that break the
+   *          rule are passed over and searched for instead. The lookahead's
+   *          second guesses aren't restricted, so it only estimates
+   */
+  void set_hard_mode(bool hard_mode);
+
+  /**
+   * @brief   Of the `candidates` words with the highest entropy, guess the
+   *          one expected to solve in the fewest guesses, looking two
+   *          guesses ahead; 0 turns the lookahead off
+   * @param   budget Time a guess may take. Words not scored in time are
+   *          passed over, so a tight budget makes guesses depend on timing
+   *          and falls back to the best word by entropy
+   */
+  void set_lookahead(std::size_t candidates, std::chrono::milliseconds budget);
+
+  /**
+   * @brief   The solutions still possible given the feedback so far
+   * @details WordleSolver::guess exits the program when there are none, as
+   *          happens when the feedback is wrong; callers that must not exit
+   *          check this first
+   */
+  [[nodiscard]] auto remaining() const -> std::size_t;
+
+  /// words branch_and_bound didn't have to score, over the solver's lifetime
+  [[nodiscard]] auto skipped_evaluations() const -> std::uint64_t {
+    return _skipped_evaluations;
+  }
+
+  /**
+   * @brief   Keep the pattern counts of the words scored from turn to turn,
+   *          with a PartitionTracker, and bring them up to date by taking
+   *          out the eliminated candidates when that's quicker than
+   *          counting afresh; on by default
+   * @details The tracker takes 2 bytes per pattern per solution, about
+   *          1.1 MB for the five-letter lists, allocated at the first search
+   *          after the opening and kept for later games. The guesses are the
+   *          same either way. Off without a pattern table
+   */
+  void set_partition_tracking(bool tracking);
+
+  /// how the tracker scored words, over the solver's lifetime
+  [[nodiscard]] auto partition_statistics() const ->
+      typename PartitionTracker::Statistics {
+    return _tracking.tracker ? _tracking.tracker->statistics()
+                             : typename PartitionTracker::Statistics{};
+  }
+
+  /**
+   * @brief   Take the guesses for the first turns from `book` instead of
+   *          evaluating entropies; nullptr turns the book off
+   * @note    The book must have been built for this solver's dictionary
+   */
+  void set_opening_book(std::shared_ptr<const OpeningBook> book);
+
+  /**
+   * @brief   Play every guess from `tree` while the feedback stays on it,
+   *          ahead of the opening book and the search; nullptr turns the
+   *          tree off
+   * @note    The tree must have been built for this solver's dictionary
+   */
+  void set_decision_tree(std::shared_ptr<const DecisionTree> tree);
+
+  /**
+   * @brief   Look searched guesses up in `cache`, and add new ones to it;
+   *          nullptr turns the cache off
+   * @details The cache may be shared by solvers on any threads, even with
+   *          other dictionaries or settings, which are part of the key. The
+   *          guesses are the ones the search would make
+   */
+  void set_guess_cache(std::shared_ptr<GuessCache> cache);
+
+  /**
+   * @brief   Record where the time of every turn goes, from the next guess
+   *          on; off by default, when it costs a branch per phase and chunk
+   * @details The phases are timed on the thread calling the solver, and the
+   *          chunks of the search on the pool threads running them. The
+   *          records stay until WordleSolver::reset
+   */
+  void set_tracing(bool tracing);
+
+  /**
+   * @brief   Compute the feedback in `rows`, which may be shared by solvers
+   *          on any threads, when the dictionary has no pattern table;
+   *          nullptr gives the solver rows of its own again. Otherwise this
+   *          does nothing
+   * @details The lookahead and the PartitionTracker, which need the table,
+   *          are off. The guesses are the ones the table gives
+   */
+  void set_feedback_rows(std::shared_ptr<FeedbackRows> rows);
+
+  /// the rows computed on demand, or nullptr with a pattern table
+  [[nodiscard]] auto feedback_rows() const -> const FeedbackRows * {
+    return _rows.get();
+  }
+
+  /// a TurnTrace per guess of this game while tracing, oldest first
+  [[nodiscard]] auto trace() const -> const std::vector<TurnTrace> & {
+    return _trace;
+  }
+
+  static constexpr int word_len = PackedWord::length;
 
  private:
+  /// the turn being recorded, or nullptr when not tracing
+  [[nodiscard]] auto traced_turn() -> TurnTrace * {
+    return _tracing && !_trace.empty() ? &_trace.back() : nullptr;
+  }
+
   /**
    * @brief   Based on the feedback, update the lists of possible solutions
    * @details Calls WordleSolver::update_internals() and
@@ -63,54 +286,160 @@ class WordleSolver {
   void update_internals();
 
   /**
-   * @brief Prune the guess list
+   * @brief Prune the guess list in a single pass over it
    */
   void prune_guess_list();
 
-  void interpret_feedback();
-  static void sort_remove_duplicates(std::vector<char> *vec);
-  void process_exclude_letters();
-  void prefer_include_over_exclude();
-  void process_first_exclude_letters();
-  void process_include_letters();
-  void process_yellow_letters();
-  void process_green_letters();
+  /// the best guess, from the cache if it has it
+  [[nodiscard]] auto eval_entropies() -> PackedWord;
+
+  /// the pattern table row of the best guess of `wordlist`
+  [[nodiscard]] auto best_row(const std::vector<std::uint32_t> &wordlist)
+      -> std::uint32_t;
+
+  /// whether guess(deadline)'s time is up or it was cancelled
+  [[nodiscard]] auto stop_requested() const -> bool;
+
+  /// whether the next search looks ahead, as set_lookahead asks unless
+  /// there is a deadline or no pattern table
+  [[nodiscard]] auto lookahead() const -> bool;
+
+  /// a hash of everything besides the candidates the search depends on
+  [[nodiscard]] auto cache_settings(
+      const std::vector<std::uint32_t> &wordlist) const -> std::uint64_t;
+
+  /// pattern table rows of the words worth guessing next
+  [[nodiscard]] auto select_wordlist() const -> std::vector<std::uint32_t>;
+
+  /**
+   * @param wordlist Pattern table rows of the candidate guesses
+   * @param first,last The range of `wordlist` to score
+   * @return The best score and its position in `wordlist`; the first one
+   *         wins a tie
+   */
+  [[nodiscard]] auto get_best_word(const std::vector<std::uint32_t> &wordlist,
+                                   std::size_t first, std::size_t last) const
+      -> std::pair<double, std::size_t>;
+
+  /**
+   * @brief Score words in order of their EntropyBound, skipping those whose
+   *        bound is below the best score found so far by any thread
+   * @return The position in `wordlist` of the word an exhaustive scan picks
+   */
+  [[nodiscard]] auto get_best_word_bounded(
+      const std::vector<std::uint32_t> &wordlist) -> std::size_t;
+
+  /**
+   * @brief Score the best words by entropy with ExpectedGuesses, in parallel
+   * @return The position in `wordlist` of the word with the fewest expected
+   *         guesses among those scored before the budget ran out; those
+   *         that weren't are left out of _search_covered
+   */
+  [[nodiscard]] auto get_best_word_lookahead(
+      const std::vector<std::uint32_t> &wordlist) -> std::size_t;
+
+  /// the best first guess by entropy, when there is no fixed_opening
+  [[nodiscard]] auto search_opening() -> PackedWord;
+
+  /// the entropy of the word in pattern table row `row` over _guess_list,
+  /// from _tracker when it tracks the row
+  [[nodiscard]] auto get_score(std::uint32_t row) const -> double;
+
+  /// count the patterns of pattern table row `row` over _guess_list
+  void count_patterns(std::uint32_t row, PatternHistogram *histogram) const;
+
+  /// with no more candidates than this, only the candidates are scored
+  static constexpr std::size_t small_list_size{5};
 
-  [[nodiscard]] auto eval_entropies() const -> std::string;
+  /// word lists and pattern table, shared between solvers
+  std::shared_ptr<const Dictionary> _dictionary;
 
-  [[nodiscard]] auto select_wordlist() const
-      -> const std::vector<std::string> *;
+  /// runs the entropy evaluation
+  std::shared_ptr<ThreadPool> _pool;
 
-  [[nodiscard]] auto
-  get_best_word(std::vector<std::string>::const_iterator first,
-                std::vector<std::string>::const_iterator last) const
-      -> std::pair<double, std::string>;
+  /// the pattern table rows, when the dictionary has none
+  std::shared_ptr<FeedbackRows> _rows;
+  /// the candidates of the search, which _rows are computed against
+  typename FeedbackRows::Candidates _candidates;
 
-  /// all valid guesses, loaded from text file
-  std::vector<std::string> _all_words;
-  /// all possible solutions, loaded from a text file
-  std::vector<std::string> _all_solutions;
+  /// whether to track, and the tracker once a search after the opening has
+  /// made one; a copy of the solver plays on apart from the original, so it
+  /// makes a tracker of its own
+  struct Tracking {
+    Tracking() = default;
+    Tracking(const Tracking &other) : on{other.on} {}
+    Tracking(Tracking &&) noexcept = default;
+    auto operator=(const Tracking &other) -> Tracking & {
+      on = other.on;
+      tracker.reset();
+      return *this;
+    }
+    auto operator=(Tracking &&) noexcept -> Tracking & = default;
+    ~Tracking() = default;
 
-  /// word entropies, i.e., the expected information
-  std::vector<std::pair<double, std::string>> _entropies;
+    bool on{true};
+    std::unique_ptr<PartitionTracker> tracker;
+  };
+  Tracking _tracking;
+
+  Search _search{Search::branch_and_bound};
+  bool _hard_mode{};
+  std::uint64_t _skipped_evaluations{};
+  std::size_t _lookahead_candidates{}; ///< 0 when the lookahead is off
+  std::chrono::milliseconds _lookahead_budget{};
+
+  /// guesses for the first turns, if set
+  std::shared_ptr<const OpeningBook> _opening_book;
+
+  /// guesses searched before, by this solver or others, if set
+  std::shared_ptr<GuessCache> _guess_cache;
+
+  bool _tracing{};
+  std::vector<TurnTrace> _trace;
+
+  /// set while guess(deadline) runs
+  std::optional<Clock::time_point> _deadline;
+  const CancellationToken *_cancel{};
+  /// words the last search had to consider, and how many it covered
+  std::size_t _search_words{};
+  std::size_t _search_covered{};
+
+  /// the strategy being played, if set
+  std::shared_ptr<const DecisionTree> _tree;
+  /// where this game is in _tree; DecisionTree::npos once off it
+  std::uint32_t _tree_node{DecisionTree::root()};
+
+  /// every five-letter game starts with this guess
+  static constexpr std::string_view first_guess{"tarse"};
+  /// whether first_guess is a word of this length and alphabet; without it,
+  /// the first guess comes from the opening book or is searched for
+  static constexpr bool fixed_opening =
+      N == 5 && std::is_same_v<Alphabet, Latin>;
+
+  [[nodiscard]] static constexpr auto opening_guess() -> PackedWord {
+    if constexpr (fixed_opening) {
+      return PackedWord{first_guess};
+    } else {
+      return PackedWord{};
+    }
+  }
 
   /// used by other methods for refining the next guess
-  std::string _last_guess = "tarse";
+  PackedWord _last_guess{opening_guess()};
   std::string _feedback; ///< feedback from last guess (eg "xxygx")
   int _iteration{};      ///< used for some control flows
 
-  std::vector<char> _include_letters; ///< solution must have
-  std::vector<char> _exclude_letters; ///< solution must not have
+  /// every feedback received this game, to look up in the opening book
+  typename OpeningBook::History _history;
 
-  std::vector<char> _letters_go_here; ///< solution has these letters here
-  std::vector<int> _pos_positions;    ///< helper for correctly placed letters
+  /// what the solution can be, given all the feedback so far
+  Constraints _constraints;
 
-  /// solution must not have these letters here
-  std::vector<char> _letters_dont_go_here;
-  std::vector<int> _neg_positions; ///< helper for incorrectly placed letters
-
-  /// the words we've narrowed it down to so far
-  std::vector<std::string> _guess_list;
+  /// the words we've narrowed it down to so far, as _all_solutions indices
+  std::vector<std::uint32_t> _guess_list;
 };
 
+/// the solver of the original five-letter game
+using WordleSolver = BasicWordleSolver<5>;
+
 #endif // WORDLE_SOLVER_INCLUDE_WORDLE_SOLVER_HPP_
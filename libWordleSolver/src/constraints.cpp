@@ -0,0 +1,144 @@
+#include "constraints.h"
+
+namespace {
+
+/// base-3 digit at `position` of a `len`-letter `pattern`
+int digit(const int pattern, const int len, const int position) {
+  int value = pattern;
+  for (int i = len - 1; i > position; --i) {
+    value /= 3;
+  }
+  return value % 3;
+}
+
+} // namespace
+
+template <int N, typename Alphabet>
+BasicConstraints<N, Alphabet>::BasicConstraints() {
+  _allowed.fill(all_letters);
+  _max_count.fill(N);
+}
+
+template <int N, typename Alphabet>
+void BasicConstraints<N, Alphabet>::add(
+    const PackedWord guess, const typename Feedback::Pattern pattern) {
+  constexpr int len = N;
+  std::array<int, PackedWord::alphabet_size> found{};
+  std::uint32_t gray{};
+
+  for (int i = 0; i < len; ++i) {
+    const auto letter = guess.letter(i);
+    const auto bit = 1U << letter;
+    if (digit(pattern, len, i) == 2) {
+      _allowed[i] = bit;
+      _green[i] = bit;
+      ++found[letter];
+    } else {
+      // a letter that isn't green here can't be here
+      _allowed[i] &= ~bit;
+      if (digit(pattern, len, i) == 1) {
+        ++found[letter];
+      } else {
+        gray |= bit;
+      }
+    }
+  }
+
+  for (int i = 0; i < len; ++i) {
+    const auto letter = guess.letter(i);
+    const auto bit = 1U << letter;
+    _min_count[letter] = static_cast<std::uint8_t>(
+        std::max<int>(_min_count[letter], found[letter]));
+    if ((gray & bit) != 0) {
+      // a gray copy means the solution has no more than the colored ones
+      _max_count[letter] = static_cast<std::uint8_t>(
+          std::min<int>(_max_count[letter], found[letter]));
+    }
+    if (_min_count[letter] > 0) {
+      _required |= bit;
+    }
+    if (_min_count[letter] > 1) {
+      _repeated |= bit;
+    }
+    if (_max_count[letter] == 0) {
+      for (auto &allowed : _allowed) {
+        allowed &= ~bit;
+      }
+    } else if (_min_count[letter] > 1 || _max_count[letter] < len) {
+      _counted |= bit;
+    }
+  }
+}
+
+template <int N, typename Alphabet>
+bool BasicConstraints<N, Alphabet>::allows(const PackedWord word) const {
+  constexpr int len = N;
+  for (int i = 0; i < len; ++i) {
+    if (((_allowed[i] >> word.letter(i)) & 1U) == 0) {
+      return false;
+    }
+  }
+  if ((word.mask() & _required) != _required) {
+    return false;
+  }
+  for (int letter = 0; (_counted >> letter) != 0; ++letter) {
+    if (((_counted >> letter) & 1U) == 0) {
+      continue;
+    }
+    int count{};
+    for (int i = 0; i < len; ++i) {
+      count += static_cast<int>(word.letter(i) == letter);
+    }
+    if (count < _min_count[letter] || count > _max_count[letter]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <int N, typename Alphabet>
+bool BasicConstraints<N, Alphabet>::allows_guess(const PackedWord word) const {
+  constexpr int len = N;
+  for (int i = 0; i < len; ++i) {
+    if (_green[i] != 0 && _green[i] != 1U << word.letter(i)) {
+      return false;
+    }
+  }
+  if ((word.mask() & _required) != _required) {
+    return false;
+  }
+  for (int letter = 0; (_repeated >> letter) != 0; ++letter) {
+    if (((_repeated >> letter) & 1U) == 0) {
+      continue;
+    }
+    int count{};
+    for (int i = 0; i < len; ++i) {
+      count += static_cast<int>(word.letter(i) == letter);
+    }
+    if (count < _min_count[letter]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <int N, typename Alphabet>
+void BasicConstraints<N, Alphabet>::filter(
+    const WordList &words, std::vector<std::uint32_t> *indices,
+    std::vector<std::uint32_t> *removed) const {
+  auto kept = indices->begin();
+  for (const auto index : *indices) {
+    if (allows(words[index])) {
+      *kept++ = index;
+    } else if (removed != nullptr) {
+      removed->push_back(index);
+    }
+  }
+  indices->erase(kept, indices->end());
+}
+
+template class BasicConstraints<4>;
+template class BasicConstraints<5>;
+template class BasicConstraints<6>;
+template class BasicConstraints<7>;
+template class BasicConstraints<8>;
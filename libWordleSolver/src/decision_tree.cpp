@@ -0,0 +1,442 @@
+#include "decision_tree.h"
+
+#include "candidate_partition.h"
+#include "dictionary.h"
+#include "entropy.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+constexpr std::array<char, 8> magic{'W', 'S', 'T', 'R', 'E', 'E', '\0', '\0'};
+constexpr std::uint32_t version{1};
+
+template <typename Feedback>
+constexpr auto solved =
+    static_cast<typename Feedback::Pattern>(Feedback::pattern_count - 1);
+
+using Cost = std::uint64_t;
+constexpr Cost infinite = std::numeric_limits<Cost>::max();
+
+/// the best guess for a candidate set, as a pattern table row, and its cost
+struct Result {
+  Cost cost{infinite};
+  std::uint32_t guess{};
+};
+
+/// two independent hashes of a candidate set, so collisions don't matter
+struct SetKey {
+  std::uint64_t first{};
+  std::uint64_t second{};
+
+  friend auto operator==(const SetKey &lhs, const SetKey &rhs) -> bool {
+    return lhs.first == rhs.first && lhs.second == rhs.second;
+  }
+};
+
+struct SetKeyHash {
+  auto operator()(const SetKey &key) const -> std::size_t {
+    return static_cast<std::size_t>(key.first);
+  }
+};
+
+auto key_of(const std::uint32_t *first, const std::uint32_t *last) -> SetKey {
+  // FNV-1a, and a multiply-xorshift mix
+  SetKey key{0xcbf29ce484222325, static_cast<std::uint64_t>(last - first)};
+  for (auto it = first; it != last; ++it) {
+    key.first = (key.first ^ *it) * 0x100000001b3;
+    key.second = (key.second + *it + 1) * 0x9e3779b97f4a7c15;
+    key.second ^= key.second >> 29U;
+  }
+  return key;
+}
+
+/// results of finished candidate sets, shared by all threads
+class Memo {
+ public:
+  [[nodiscard]] auto find(const SetKey &key) -> std::optional<Result> {
+    auto &shard = _shards[key.second % shard_count];
+    const std::lock_guard lock(shard.mutex);
+    const auto found = shard.results.find(key);
+    if (found == shard.results.end()) {
+      return std::nullopt;
+    }
+    return found->second;
+  }
+
+  void insert(const SetKey &key, const Result result) {
+    auto &shard = _shards[key.second % shard_count];
+    const std::lock_guard lock(shard.mutex);
+    shard.results.emplace(key, result);
+  }
+
+ private:
+  static constexpr std::size_t shard_count{64};
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<SetKey, Result, SetKeyHash> results;
+  };
+  std::array<Shard, shard_count> _shards;
+};
+
+/// exact search over the best few guesses of every candidate set
+template <int N, typename Alphabet> class Search {
+ public:
+  using Tree = BasicDecisionTree<N, Alphabet>;
+  using Objective = typename Tree::Objective;
+  using Feedback = BasicFeedback<N, Alphabet>;
+  using CandidatePartition = BasicCandidatePartition<Feedback>;
+
+  Search(const BasicDictionary<N, Alphabet> &dictionary,
+         const std::size_t candidates, const Objective objective,
+         ThreadPool *pool)
+      : _patterns{dictionary.patterns()}, _candidates{candidates},
+        _objective{objective}, _pool{pool} {}
+
+  /// the best guess for the candidates [first, last)
+  auto solve(const std::uint32_t *first, const std::uint32_t *last,
+             const int depth) -> Result {
+    const auto size = static_cast<std::size_t>(last - first);
+    if (size <= 2) {
+      // guess one; the other, if any, comes next
+      const Cost cost = _objective == Objective::average
+                            ? 2 * size - 1
+                            : size;
+      return {cost, _patterns.solution_rows()[*first]};
+    }
+    const auto key = key_of(first, last);
+    if (const auto found = _memo.find(key)) {
+      return *found;
+    }
+
+    Result best;
+    for (const auto row : guesses(first, last)) {
+      const CandidatePartition partition{_patterns.row(row), first, last};
+      const auto cost = evaluate(partition, size, depth, best.cost);
+      if (cost < best.cost) {
+        best = {cost, row};
+      }
+    }
+    _memo.insert(key, best);
+    return best;
+  }
+
+ private:
+  /// sets at most this deep have their parts solved in parallel
+  static constexpr int parallel_depth{1};
+  /// sets at least this large have their guesses scored in parallel
+  static constexpr std::size_t parallel_size{256};
+
+  /**
+   * @return The cost of guessing the word that made `partition`, or
+   *         `infinite` if it is sure to reach `bound`
+   */
+  auto evaluate(const CandidatePartition &partition, const std::size_t size,
+                const int depth, const Cost bound) -> Cost {
+    std::vector<std::size_t> parts;
+    Cost lower{};
+    for (std::size_t pattern = 0; pattern < Feedback::pattern_count;
+         ++pattern) {
+      const auto part = partition.size(pattern);
+      if (part == 0 || pattern == solved<Feedback>) {
+        continue;
+      }
+      if (part == size) {
+        return infinite; // tells nothing apart
+      }
+      parts.push_back(pattern);
+      lower = combine(lower, minimum_cost(part));
+    }
+    if (finish(lower, size) >= bound) {
+      return infinite;
+    }
+
+    if (depth < parallel_depth) {
+      const auto total = _pool->parallel_reduce(
+          parts.size(), 1, Cost{},
+          [this, &partition, &parts, depth](const std::size_t begin,
+                                            const std::size_t end,
+                                            Cost &subtotal) {
+            for (auto i = begin; i < end; ++i) {
+              subtotal = combine(subtotal,
+                                 solve(partition.begin(parts[i]),
+                                       partition.end(parts[i]), depth + 1)
+                                     .cost);
+            }
+          },
+          [this](const Cost lhs, const Cost rhs) { return combine(lhs, rhs); });
+      return finish(total, size);
+    }
+
+    Cost total{};
+    for (const auto pattern : parts) {
+      total = combine(total, solve(partition.begin(pattern),
+                                   partition.end(pattern), depth + 1)
+                                 .cost);
+      if (finish(total, size) >= bound) {
+        return infinite;
+      }
+    }
+    return finish(total, size);
+  }
+
+  /// the cost of two sets of parts together
+  [[nodiscard]] auto combine(const Cost lhs, const Cost rhs) const -> Cost {
+    return _objective == Objective::average ? lhs + rhs
+                                                          : std::max(lhs, rhs);
+  }
+
+  /// the cost of a set, given the combined cost of its parts
+  [[nodiscard]] auto finish(const Cost parts, const std::size_t size) const
+      -> Cost {
+    return _objective == Objective::average ? parts + size
+                                                          : parts + 1;
+  }
+
+  /// no set of `size` can cost less: one guess each, a second for all but one
+  [[nodiscard]] auto minimum_cost(const std::size_t size) const -> Cost {
+    if (_objective == Objective::average) {
+      return 2 * size - 1;
+    }
+    return size == 1 ? 1 : 2;
+  }
+
+  /**
+   * @return The rows to try: the best by entropy, and the best candidate
+   *         among them or after them, highest entropy first
+   */
+  auto guesses(const std::uint32_t *first, const std::uint32_t *last) const
+      -> std::vector<std::uint32_t> {
+    const auto size = static_cast<std::size_t>(last - first);
+    std::vector<double> scores(_patterns.guess_count());
+    const auto score_rows = [this, first, last,
+                             &scores](const std::size_t begin,
+                                      const std::size_t end) {
+      std::array<std::uint32_t, Feedback::pattern_count> counts{};
+      std::vector<typename Feedback::Pattern> seen;
+      for (auto row = begin; row < end; ++row) {
+        const auto *patterns = _patterns.row(row);
+        for (auto it = first; it != last; ++it) {
+          if (counts[patterns[*it]]++ == 0) {
+            seen.push_back(patterns[*it]);
+          }
+        }
+        // entropy less log2 of the set size, which is the same for all
+        double sum{};
+        for (const auto pattern : seen) {
+          sum += Entropy::n_log2_n(counts[pattern]);
+          counts[pattern] = 0;
+        }
+        seen.clear();
+        scores[row] = -sum;
+      }
+    };
+    if (size >= parallel_size) {
+      _pool->parallel_for(scores.size(), 64, score_rows);
+    } else {
+      score_rows(0, scores.size());
+    }
+
+    const auto higher = [&scores](const std::uint32_t lhs,
+                                  const std::uint32_t rhs) {
+      return scores[lhs] != scores[rhs] ? scores[lhs] > scores[rhs]
+                                        : lhs < rhs;
+    };
+    std::vector<std::uint32_t> rows(scores.size());
+    std::iota(rows.begin(), rows.end(), 0);
+    const auto count = std::min(_candidates, rows.size());
+    std::partial_sort(rows.begin(), rows.begin() + count, rows.end(), higher);
+    rows.resize(count);
+
+    auto best_candidate = _patterns.solution_rows()[*first];
+    for (auto it = first; it != last; ++it) {
+      best_candidate =
+          std::min(best_candidate, _patterns.solution_rows()[*it], higher);
+    }
+    if (std::find(rows.begin(), rows.end(), best_candidate) == rows.end()) {
+      rows.push_back(best_candidate);
+    }
+    return rows;
+  }
+
+  const BasicPatternTable<N, Alphabet> &_patterns;
+  std::size_t _candidates;
+  Objective _objective;
+  ThreadPool *_pool;
+  Memo _memo;
+};
+
+template <typename T> void write(std::ofstream &out, const T &value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T> auto read(std::ifstream &in) -> T {
+  T value{};
+  in.read(reinterpret_cast<char *>(&value), sizeof(value));
+  return value;
+}
+
+} // namespace
+
+template <int N, typename Alphabet>
+std::uint32_t BasicDecisionTree<N, Alphabet>::next(
+    const std::uint32_t node, const typename Feedback::Pattern pattern) const {
+  const auto first = _children.begin() + _nodes[node].first_child;
+  const auto last = first + _nodes[node].child_count;
+  const auto child = std::lower_bound(
+      first, last, pattern, [](const Child &lhs, const std::uint32_t rhs) {
+        return lhs.pattern < rhs;
+      });
+  return child != last && child->pattern == pattern ? child->node : npos;
+}
+
+template <int N, typename Alphabet>
+auto BasicDecisionTree<N, Alphabet>::build(
+    const std::shared_ptr<const Dictionary> &dictionary,
+    const std::size_t candidates, const Objective objective, ThreadPool *pool)
+    -> std::shared_ptr<const BasicDecisionTree> {
+  if (!dictionary->has_table()) {
+    throw std::invalid_argument("a decision tree needs a pattern table");
+  }
+  const auto &patterns = dictionary->patterns();
+  Search<N, Alphabet> search{*dictionary, std::max<std::size_t>(1, candidates),
+                             objective, pool};
+  std::vector<std::uint32_t> all(dictionary->all_solutions().size());
+  std::iota(all.begin(), all.end(), 0);
+
+  auto tree = std::make_shared<BasicDecisionTree>();
+  tree->_objective = objective;
+  tree->_fingerprint = dictionary->fingerprint();
+
+  // lay the searched tree out depth first; each node's children are
+  // appended together once their subtrees are done
+  const auto add = [&](const auto &self, const std::uint32_t *first,
+                       const std::uint32_t *last,
+                       const std::uint32_t guesses) -> std::uint32_t {
+    const auto row = search.solve(first, last, 0).guess;
+    const auto index = static_cast<std::uint32_t>(tree->_nodes.size());
+    tree->_nodes.push_back({patterns.guesses()[row].key(), 0, 0});
+
+    const BasicCandidatePartition<Feedback> partition{patterns.row(row), first,
+                                                      last};
+    std::vector<Child> children;
+    for (std::size_t pattern = 0; pattern < Feedback::pattern_count;
+         ++pattern) {
+      if (partition.size(pattern) == 0) {
+        continue;
+      }
+      if (pattern == solved<Feedback>) {
+        tree->_total_guesses += guesses;
+        tree->_max_guesses = std::max(tree->_max_guesses, guesses);
+        continue;
+      }
+      children.push_back(
+          {static_cast<std::uint32_t>(pattern),
+           self(self, partition.begin(pattern), partition.end(pattern),
+                guesses + 1)});
+    }
+    tree->_nodes[index].first_child =
+        static_cast<std::uint32_t>(tree->_children.size());
+    tree->_nodes[index].child_count =
+        static_cast<std::uint32_t>(children.size());
+    tree->_children.insert(tree->_children.end(), children.begin(),
+                           children.end());
+    return index;
+  };
+  add(add, all.data(), all.data() + all.size(), 1);
+  return tree;
+}
+
+template <int N, typename Alphabet>
+void BasicDecisionTree<N, Alphabet>::save(const std::string &file_name) const {
+  std::ofstream out(file_name, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error("Failed to open file " + file_name);
+  }
+  out.write(magic.data(), magic.size());
+  write(out, version);
+  write(out, _objective);
+  write(out, _fingerprint);
+  write(out, _total_guesses);
+  write(out, _max_guesses);
+  write(out, static_cast<std::uint32_t>(_nodes.size()));
+  write(out, static_cast<std::uint32_t>(_children.size()));
+  for (const auto &node : _nodes) {
+    write(out, node);
+  }
+  for (const auto &child : _children) {
+    write(out, child);
+  }
+  if (!out) {
+    throw std::runtime_error("Failed to write file " + file_name);
+  }
+}
+
+template <int N, typename Alphabet>
+auto BasicDecisionTree<N, Alphabet>::load(const std::string &file_name,
+                                          const Dictionary &dictionary)
+    -> std::shared_ptr<const BasicDecisionTree> {
+  std::ifstream in(file_name, std::ios::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error("Failed to open file " + file_name);
+  }
+  std::array<char, magic.size()> header{};
+  in.read(header.data(), header.size());
+  if (!in || header != magic || read<std::uint32_t>(in) != version) {
+    throw std::runtime_error(file_name + " is not a decision tree");
+  }
+
+  auto tree = std::make_shared<BasicDecisionTree>();
+  tree->_objective = read<Objective>(in);
+  tree->_fingerprint = read<std::uint64_t>(in);
+  tree->_total_guesses = read<std::uint64_t>(in);
+  tree->_max_guesses = read<std::uint32_t>(in);
+  const auto node_count = read<std::uint32_t>(in);
+  const auto child_count = read<std::uint32_t>(in);
+  if (!in) {
+    throw std::runtime_error(file_name + " is not a decision tree");
+  }
+  if (tree->_fingerprint != dictionary.fingerprint()) {
+    throw std::runtime_error(file_name +
+                             " was built for a different dictionary");
+  }
+
+  for (std::uint32_t i = 0; i < node_count && in; ++i) {
+    tree->_nodes.push_back(read<Node>(in));
+  }
+  for (std::uint32_t i = 0; i < child_count && in; ++i) {
+    tree->_children.push_back(read<Child>(in));
+  }
+  const auto &guesses = dictionary.patterns().guesses();
+  const auto valid_node = [&](const Node &node) {
+    return node.first_child <= child_count &&
+           node.child_count <= child_count - node.first_child &&
+           guesses.index_of(PackedWord::from_key(node.guess)) != guesses.npos;
+  };
+  const auto valid_child = [node_count](const Child &child) {
+    return child.pattern < Feedback::pattern_count && child.node < node_count;
+  };
+  if (!in || node_count == 0 ||
+      !std::all_of(tree->_nodes.begin(), tree->_nodes.end(), valid_node) ||
+      !std::all_of(tree->_children.begin(), tree->_children.end(),
+                   valid_child)) {
+    throw std::runtime_error(file_name + " is truncated or corrupt");
+  }
+  return tree;
+}
+
+template class BasicDecisionTree<4>;
+template class BasicDecisionTree<5>;
+template class BasicDecisionTree<6>;
+template class BasicDecisionTree<7>;
+template class BasicDecisionTree<8>;
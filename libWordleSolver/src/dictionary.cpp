@@ -0,0 +1,133 @@
+#include "dictionary.h"
+
+#include "embedded_word_lists.h"
+#include "wordle_solver.h"
+
+#include <array>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+/// the packed words of `keys`, unpacked by the compiler
+template <std::size_t N>
+constexpr auto unpack(const std::uint32_t (&keys)[N])
+    -> std::array<PackedWord, N> {
+  std::array<PackedWord, N> words{};
+  for (std::size_t i = 0; i < N; ++i) {
+    words[i] = PackedWord::from_key(keys[i]);
+  }
+  return words;
+}
+
+constexpr auto embedded_all_words = unpack(embedded_word_lists::all_words);
+constexpr auto embedded_all_solutions =
+    unpack(embedded_word_lists::all_solutions);
+
+/// "word_lists/<name>.txt", or "word_lists/<name>_<N>.txt" if N isn't five
+std::string word_list_file(const std::string &name, const int length) {
+  const auto suffix = length == PackedWord::length
+                          ? std::string{}
+                          : '_' + std::to_string(length);
+  return "word_lists/" + name + suffix + ".txt";
+}
+
+} // namespace
+
+template <int N, typename Alphabet>
+BasicDictionary<N, Alphabet>::BasicDictionary(WordList all_words,
+                                              WordList all_solutions,
+                                              const Storage storage)
+    : _all_words{std::move(all_words)},
+      _all_solutions{std::move(all_solutions)},
+      _patterns{_all_words, _all_solutions, storage == Storage::table} {
+  fingerprint_words();
+}
+
+template <int N, typename Alphabet>
+BasicDictionary<N, Alphabet>::BasicDictionary(WordList all_words,
+                                              WordList all_solutions,
+                                              PatternTable patterns)
+    : _all_words{std::move(all_words)},
+      _all_solutions{std::move(all_solutions)},
+      _patterns{std::move(patterns)} {
+  fingerprint_words();
+}
+
+template <int N, typename Alphabet>
+void BasicDictionary<N, Alphabet>::fingerprint_words() {
+  // FNV-1a over the packed words, with the list sizes as separators
+  constexpr std::uint64_t prime{0x100000001b3};
+  _fingerprint = 0xcbf29ce484222325;
+  const auto mix = [this](const std::uint64_t value) {
+    _fingerprint = (_fingerprint ^ value) * prime;
+  };
+  for (const auto *list : {&_all_words, &_all_solutions}) {
+    mix(list->size());
+    for (const auto word : *list) {
+      mix(word.key());
+    }
+  }
+}
+
+template <int N, typename Alphabet>
+auto BasicDictionary<N, Alphabet>::load(
+    const std::string_view all_words_file,
+    const std::string_view all_solutions_file, const Storage storage)
+    -> std::shared_ptr<const BasicDictionary> {
+  using Solver = BasicWordleSolver<N, Alphabet>;
+  return std::make_shared<const BasicDictionary>(
+      WordList{Solver::load_wordlist(all_words_file)},
+      WordList{Solver::load_wordlist(all_solutions_file)}, storage);
+}
+
+template <int N, typename Alphabet>
+auto BasicDictionary<N, Alphabet>::from_memory(
+    const char *all_words, const unsigned int all_words_length,
+    const char *all_solutions, const unsigned int all_solutions_length)
+    -> std::shared_ptr<const BasicDictionary> {
+  using Solver = BasicWordleSolver<N, Alphabet>;
+  return std::make_shared<const BasicDictionary>(
+      WordList{Solver::load_wordlist(all_words, all_words_length)},
+      WordList{Solver::load_wordlist(all_solutions, all_solutions_length)});
+}
+
+template <int N, typename Alphabet>
+auto BasicDictionary<N, Alphabet>::shared_default()
+    -> std::shared_ptr<const BasicDictionary> {
+  static std::once_flag loaded;
+  static std::shared_ptr<const BasicDictionary> dictionary;
+  std::call_once(loaded, [] {
+    dictionary = load(word_list_file("all_words", N),
+                      word_list_file("all_solutions", N));
+  });
+  return dictionary;
+}
+
+template <int N, typename Alphabet>
+auto BasicDictionary<N, Alphabet>::embedded()
+    -> std::shared_ptr<const BasicDictionary> {
+  if constexpr (std::is_same_v<PackedWord, ::PackedWord>) {
+    static std::once_flag built;
+    static std::shared_ptr<const BasicDictionary> dictionary;
+    std::call_once(built, [] {
+      // the arrays are static, so the lists can view them in place
+      dictionary = std::make_shared<const BasicDictionary>(
+          WordList::view(embedded_all_words.data(), embedded_all_words.size(),
+                         nullptr),
+          WordList::view(embedded_all_solutions.data(),
+                         embedded_all_solutions.size(), nullptr));
+    });
+    return dictionary;
+  } else {
+    throw std::runtime_error("no " + std::to_string(N) +
+                             "-letter word lists are compiled in");
+  }
+}
+
+template class BasicDictionary<4>;
+template class BasicDictionary<5>;
+template class BasicDictionary<6>;
+template class BasicDictionary<7>;
+template class BasicDictionary<8>;
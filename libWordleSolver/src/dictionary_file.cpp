@@ -0,0 +1,325 @@
+// Dictionary::save and Dictionary::map: the binary dictionary format
+
+#include "dictionary.h"
+
+#include "mapped_file.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<PackedWord> &&
+                  sizeof(PackedWord) == 2 * sizeof(std::uint32_t),
+              "packed words are stored in the file as they are in memory");
+
+constexpr std::array<char, 8> magic{'W', 'S', 'D', 'I', 'C', 'T', '\0', '\0'};
+constexpr std::uint32_t version{2};
+/// reads back differently on a machine of the other endianness
+constexpr std::uint32_t byte_order{0x01020304};
+/// every section starts on a cache line
+constexpr std::uint64_t alignment{64};
+
+/**
+ * The file starts with this header, followed by these sections:
+ * - rows: all_words, then the solutions that aren't among them
+ * - all_solutions
+ * - solution rows (pattern_table only): the row of every solution
+ * - patterns (pattern_table only): rows x all_solutions, row-major
+ * Words are stored as BasicPackedWord values with letter_masks, and as
+ * BasicPackedWord::key values without.
+ */
+struct Header {
+  std::array<char, 8> magic;
+  std::uint32_t version;
+  std::uint32_t byte_order;
+  std::uint32_t word_length;    ///< letters per word
+  std::uint32_t alphabet;       ///< first letter << 8 | alphabet size
+  std::uint32_t sections;       ///< Dictionary::Section flags
+  std::uint32_t word_count;     ///< all_words, the first rows
+  std::uint32_t row_count;      ///< rows stored
+  std::uint32_t solution_count; ///< all_solutions
+  std::uint64_t fingerprint;    ///< Dictionary::fingerprint
+  std::uint64_t rows_offset;
+  std::uint64_t solutions_offset;
+  std::uint64_t solution_rows_offset;
+  std::uint64_t patterns_offset;
+};
+
+auto aligned(const std::uint64_t offset) -> std::uint64_t {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+template <typename Word>
+auto word_size(const unsigned sections) -> std::uint64_t {
+  return (sections & Dictionary::letter_masks) != 0
+             ? sizeof(Word)
+             : sizeof(typename Word::Key);
+}
+
+template <typename Alphabet> auto alphabet() -> std::uint32_t {
+  return static_cast<std::uint32_t>(Alphabet::first) << 8U |
+         static_cast<std::uint32_t>(Alphabet::size);
+}
+
+/// whether a word read from a file is one BasicPackedWord could have made
+template <typename Word> auto valid(const Word word) -> bool {
+  constexpr auto key_bits = Word::length * Word::letter_bits;
+  if constexpr (key_bits < 8 * sizeof(typename Word::Key)) {
+    if ((word.key() >> key_bits) != 0) {
+      return false;
+    }
+  }
+  for (int i = 0; i < Word::length; ++i) {
+    if (word.letter(i) >= Word::alphabet_size) {
+      return false;
+    }
+  }
+  // the whole mask, as wide as the key, must match
+  const auto made = Word::from_key(word.key());
+  return std::memcmp(&word, &made, sizeof(Word)) == 0;
+}
+
+/// checked access to the sections of a mapped dictionary
+class Reader {
+ public:
+  Reader(std::shared_ptr<const MappedFile> file, std::string file_name)
+      : _file{std::move(file)}, _file_name{std::move(file_name)} {}
+
+  [[noreturn]] void fail(const std::string &reason) const {
+    throw std::runtime_error(_file_name + ' ' + reason);
+  }
+
+  template <typename T>
+  auto section(const std::uint64_t offset, const std::uint64_t count) const
+      -> const T * {
+    if (offset % alignof(T) != 0 || offset > _file->size() ||
+        count > (_file->size() - offset) / sizeof(T)) {
+      fail("is truncated or corrupt");
+    }
+    return reinterpret_cast<const T *>(_file->data() + offset);
+  }
+
+  /// `count` words at `offset`, viewed in place if they have letter masks
+  template <typename WordList>
+  auto words(const std::uint64_t offset, const std::size_t count,
+             const unsigned sections) const -> WordList {
+    using Word = typename WordList::PackedWord;
+    if ((sections & Dictionary::letter_masks) != 0) {
+      const auto *words = section<Word>(offset, count);
+      if (!std::all_of(words, words + count, valid<Word>)) {
+        fail("holds an invalid word");
+      }
+      return WordList::view(words, count, _file);
+    }
+    const auto *keys = section<typename Word::Key>(offset, count);
+    WordList list;
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto word = Word::from_key(keys[i]);
+      if (!valid(word)) {
+        fail("holds an invalid word");
+      }
+      list.push_back(word);
+    }
+    return list;
+  }
+
+  [[nodiscard]] auto file() const -> const std::shared_ptr<const MappedFile> & {
+    return _file;
+  }
+
+ private:
+  std::shared_ptr<const MappedFile> _file;
+  std::string _file_name;
+};
+
+/// writes sections at their offsets, padding the gaps with zeros
+class Writer {
+ public:
+  explicit Writer(std::ofstream *out) : _out{out} {}
+
+  void seek(const std::uint64_t offset) {
+    static constexpr std::array<char, alignment> zeros{};
+    while (_offset < offset) {
+      const auto gap = std::min<std::uint64_t>(offset - _offset, zeros.size());
+      write(zeros.data(), gap);
+    }
+  }
+
+  void write(const void *bytes, const std::uint64_t size) {
+    _out->write(static_cast<const char *>(bytes),
+                static_cast<std::streamsize>(size));
+    _offset += size;
+  }
+
+  template <typename WordList>
+  void words(const WordList &words, const unsigned sections) {
+    using Word = typename WordList::PackedWord;
+    static_assert(std::is_trivially_copyable_v<Word> &&
+                      std::has_unique_object_representations_v<Word>,
+                  "packed words are written without padding bytes");
+    if ((sections & Dictionary::letter_masks) != 0) {
+      write(words.data(), words.size() * sizeof(*words.data()));
+      return;
+    }
+    for (const auto word : words) {
+      const auto key = word.key();
+      write(&key, sizeof(key));
+    }
+  }
+
+ private:
+  std::ofstream *_out;
+  std::uint64_t _offset{};
+};
+
+} // namespace
+
+template <int N, typename Alphabet>
+void BasicDictionary<N, Alphabet>::save(const std::string &file_name,
+                                        const unsigned sections) const {
+  using Pattern = typename PatternTable::Pattern;
+  const bool table = (sections & pattern_table) != 0 && has_table();
+  const auto &rows = table ? _patterns.guesses() : _all_words;
+  const auto solution_count = _all_solutions.size();
+
+  Header header{};
+  header.magic = magic;
+  header.version = version;
+  header.byte_order = byte_order;
+  header.word_length = N;
+  header.alphabet = alphabet<Alphabet>();
+  header.sections = (sections & letter_masks) | (table ? pattern_table : 0U);
+  header.word_count = static_cast<std::uint32_t>(_all_words.size());
+  header.row_count = static_cast<std::uint32_t>(rows.size());
+  header.solution_count = static_cast<std::uint32_t>(solution_count);
+  header.fingerprint = _fingerprint;
+  header.rows_offset = aligned(sizeof(Header));
+  const auto word_bytes = word_size<PackedWord>(sections);
+  header.solutions_offset =
+      aligned(header.rows_offset + rows.size() * word_bytes);
+  if (table) {
+    header.solution_rows_offset =
+        aligned(header.solutions_offset + solution_count * word_bytes);
+    header.patterns_offset = aligned(header.solution_rows_offset +
+                                     solution_count * sizeof(std::uint32_t));
+  }
+
+  std::ofstream out(file_name, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error("Failed to open file " + file_name);
+  }
+  Writer writer{&out};
+  writer.write(&header, sizeof(header));
+  writer.seek(header.rows_offset);
+  writer.words(rows, sections);
+  writer.seek(header.solutions_offset);
+  writer.words(_all_solutions, sections);
+  if (table) {
+    writer.seek(header.solution_rows_offset);
+    writer.write(_patterns.solution_rows().data(),
+                 solution_count * sizeof(std::uint32_t));
+    writer.seek(header.patterns_offset);
+    writer.write(_patterns.data(),
+                 rows.size() * solution_count * sizeof(Pattern));
+  }
+  if (!out) {
+    throw std::runtime_error("Failed to write file " + file_name);
+  }
+}
+
+template <int N, typename Alphabet>
+auto BasicDictionary<N, Alphabet>::map(const std::string &file_name)
+    -> std::shared_ptr<const BasicDictionary> {
+  using Pattern = typename PatternTable::Pattern;
+  const Reader reader{std::make_shared<const MappedFile>(file_name),
+                      file_name};
+
+  Header header{};
+  std::memcpy(&header, reader.section<std::byte>(0, sizeof(header)),
+              sizeof(header));
+  if (header.magic != magic) {
+    reader.fail("is not a dictionary");
+  }
+  if (header.version != version || header.byte_order != byte_order) {
+    reader.fail("was written by an incompatible version");
+  }
+  if (header.word_length != N || header.alphabet != alphabet<Alphabet>()) {
+    reader.fail("holds words of another length or alphabet");
+  }
+  const bool table = (header.sections & pattern_table) != 0;
+  if ((header.sections & ~(letter_masks | pattern_table)) != 0 ||
+      header.row_count < header.word_count ||
+      (!table && header.row_count != header.word_count)) {
+    reader.fail("is truncated or corrupt");
+  }
+
+  auto rows = reader.words<WordList>(header.rows_offset, header.row_count,
+                                     header.sections);
+  auto all_solutions = reader.words<WordList>(
+      header.solutions_offset, header.solution_count, header.sections);
+  auto all_words =
+      (header.sections & letter_masks) != 0
+          ? WordList::view(rows.data(), header.word_count, reader.file())
+          : WordList{};
+  if (all_words.size() != header.word_count) {
+    std::for_each(rows.begin(), rows.begin() + header.word_count,
+                  [&all_words](const PackedWord word) {
+                    all_words.push_back(word);
+                  });
+  }
+
+  if (!table) {
+    auto dictionary = std::make_shared<const BasicDictionary>(
+        std::move(all_words), std::move(all_solutions));
+    if (dictionary->fingerprint() != header.fingerprint) {
+      reader.fail("is truncated or corrupt");
+    }
+    return dictionary;
+  }
+
+  const auto *solution_rows = reader.section<std::uint32_t>(
+      header.solution_rows_offset, header.solution_count);
+  for (std::uint32_t i = 0; i < header.solution_count; ++i) {
+    if (solution_rows[i] >= header.row_count ||
+        !(rows[solution_rows[i]] == all_solutions[i])) {
+      reader.fail("is truncated or corrupt");
+    }
+  }
+  const auto *patterns = reader.section<Pattern>(
+      header.patterns_offset,
+      std::uint64_t{header.row_count} * header.solution_count);
+
+  PatternTable table_view{
+      std::move(rows), all_solutions,
+      std::vector<std::uint32_t>(solution_rows,
+                                 solution_rows + header.solution_count),
+      patterns, reader.file()};
+  auto dictionary = std::shared_ptr<const BasicDictionary>(
+      new BasicDictionary(std::move(all_words), std::move(all_solutions),
+                          std::move(table_view)));
+  if (dictionary->fingerprint() != header.fingerprint) {
+    reader.fail("is truncated or corrupt");
+  }
+  return dictionary;
+}
+
+template void BasicDictionary<4>::save(const std::string &, unsigned) const;
+template void BasicDictionary<5>::save(const std::string &, unsigned) const;
+template void BasicDictionary<6>::save(const std::string &, unsigned) const;
+template void BasicDictionary<7>::save(const std::string &, unsigned) const;
+template void BasicDictionary<8>::save(const std::string &, unsigned) const;
+template auto BasicDictionary<4>::map(const std::string &)
+    -> std::shared_ptr<const BasicDictionary>;
+template auto BasicDictionary<5>::map(const std::string &)
+    -> std::shared_ptr<const BasicDictionary>;
+template auto BasicDictionary<6>::map(const std::string &)
+    -> std::shared_ptr<const BasicDictionary>;
+template auto BasicDictionary<7>::map(const std::string &)
+    -> std::shared_ptr<const BasicDictionary>;
+template auto BasicDictionary<8>::map(const std::string &)
+    -> std::shared_ptr<const BasicDictionary>;
@@ -0,0 +1,62 @@
+#include "entropy_bound.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+auto surprisal(const double probability) -> double {
+  return probability > 0.0 ? -probability * std::log2(probability) : 0.0;
+}
+
+} // namespace
+
+template <int N, typename Alphabet>
+BasicEntropyBound<N, Alphabet>::BasicEntropyBound(
+    const WordList &solutions, const std::vector<std::uint32_t> &candidates) {
+  using Tally = std::array<std::uint32_t, PackedWord::alphabet_size>;
+  std::array<Tally, PackedWord::length> at_position{};
+  Tally anywhere{};
+  for (const auto index : candidates) {
+    const auto word = solutions[index];
+    for (int i = 0; i < PackedWord::length; ++i) {
+      ++at_position[i][word.letter(i)];
+    }
+    for (int letter = 0; letter < PackedWord::alphabet_size; ++letter) {
+      anywhere[letter] += (word.mask() >> letter) & 1U;
+    }
+  }
+
+  if (candidates.empty()) {
+    return;
+  }
+  const auto total = static_cast<double>(candidates.size());
+  _set_bound = std::log2(total);
+  for (int i = 0; i < PackedWord::length; ++i) {
+    for (int letter = 0; letter < PackedWord::alphabet_size; ++letter) {
+      const double green = at_position[i][letter] / total;
+      const double rest = 1.0 - green;
+      // the entropy of the rest grows with yellow up to an even split
+      const double yellow = std::min(
+          (anywhere[letter] - at_position[i][letter]) / total, rest / 2.0);
+      _position_bounds[i][letter] =
+          surprisal(green) + surprisal(yellow) + surprisal(rest - yellow);
+    }
+  }
+}
+
+template <int N, typename Alphabet>
+double
+BasicEntropyBound<N, Alphabet>::operator()(const PackedWord guess) const {
+  double bound{};
+  for (int i = 0; i < PackedWord::length; ++i) {
+    bound += _position_bounds[i][guess.letter(i)];
+  }
+  return std::min(bound, _set_bound);
+}
+
+template class BasicEntropyBound<4>;
+template class BasicEntropyBound<5>;
+template class BasicEntropyBound<6>;
+template class BasicEntropyBound<7>;
+template class BasicEntropyBound<8>;
@@ -0,0 +1,109 @@
+#include "expected_guesses.h"
+
+#include "candidate_partition.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+/// the pattern of a guess that solves the puzzle
+template <typename Feedback>
+constexpr auto solved =
+    static_cast<typename Feedback::Pattern>(Feedback::pattern_count - 1);
+
+} // namespace
+
+template <int N, typename Alphabet>
+BasicExpectedGuesses<N, Alphabet>::BasicExpectedGuesses(
+    const PatternTable &patterns,
+    const std::vector<std::uint32_t> &second_guesses,
+    const Clock::time_point deadline)
+    : _patterns{patterns}, _second_guesses{second_guesses},
+      _deadline{deadline} {}
+
+template <int N, typename Alphabet>
+double BasicExpectedGuesses<N, Alphabet>::estimate(
+    const std::size_t candidates) {
+  // Guessing one of n candidates, when the guess also tells the others
+  // apart, takes 2 - 1/n guesses. Larger sets need about one more guess for
+  // every ~5.5 bits, the most a guess gains in practice.
+  if (candidates <= 1) {
+    return static_cast<double>(candidates);
+  }
+  const auto n = static_cast<double>(candidates);
+  constexpr double bits_per_guess{5.5};
+  return 2.0 - 1.0 / n + std::log2(n / 2.0) / bits_per_guess;
+}
+
+template <int N, typename Alphabet>
+std::optional<double> BasicExpectedGuesses<N, Alphabet>::operator()(
+    const std::uint32_t row,
+    const std::vector<std::uint32_t> &candidates) const {
+  using Feedback = typename PatternTable::Feedback;
+  const BasicCandidatePartition<Feedback> partition{
+      _patterns.row(row), candidates.data(),
+      candidates.data() + candidates.size()};
+  double total{};
+  for (std::size_t pattern = 0; pattern < Feedback::pattern_count; ++pattern) {
+    const auto size = partition.size(pattern);
+    if (size == 0 || pattern == solved<Feedback>) {
+      continue;
+    }
+    const auto guesses =
+        second_ply(partition.begin(pattern), partition.end(pattern));
+    if (!guesses) {
+      return std::nullopt;
+    }
+    total += size * *guesses;
+  }
+  return 1.0 + total / static_cast<double>(candidates.size());
+}
+
+template <int N, typename Alphabet>
+std::optional<double>
+BasicExpectedGuesses<N, Alphabet>::second_ply(const std::uint32_t *first,
+                                              const std::uint32_t *last) const {
+  using Feedback = typename PatternTable::Feedback;
+  // reading the clock for every guess would cost more than some guesses
+  constexpr std::size_t clock_interval{64};
+
+  const auto size = static_cast<std::size_t>(last - first);
+  if (size <= 2) {
+    return estimate(size);
+  }
+
+  double best{std::numeric_limits<double>::max()};
+  std::array<std::uint32_t, Feedback::pattern_count> counts{};
+  std::vector<typename Feedback::Pattern> seen;
+  seen.reserve(size);
+  for (std::size_t i = 0; i < _second_guesses.size(); ++i) {
+    if (i % clock_interval == 0 && Clock::now() > _deadline) {
+      return std::nullopt;
+    }
+    const auto *row = _patterns.row(_second_guesses[i]);
+    for (auto it = first; it != last; ++it) {
+      if (counts[row[*it]]++ == 0) {
+        seen.push_back(row[*it]);
+      }
+    }
+    double total{};
+    for (const auto pattern : seen) {
+      if (pattern != solved<Feedback>) {
+        total += counts[pattern] * estimate(counts[pattern]);
+      }
+      counts[pattern] = 0;
+    }
+    seen.clear();
+    best = std::min(best, total);
+  }
+  return 1.0 + best / static_cast<double>(size);
+}
+
+template class BasicExpectedGuesses<4>;
+template class BasicExpectedGuesses<5>;
+template class BasicExpectedGuesses<6>;
+template class BasicExpectedGuesses<7>;
+template class BasicExpectedGuesses<8>;
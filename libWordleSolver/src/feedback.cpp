@@ -1,58 +1,132 @@
 #include "feedback.h"
 
-using Code_element = std::bitset<Feedback::feedback_char_bits>;
-using Code = std::bitset<Feedback::feedback_word_bits>;
+#include <array>
 
-Code Feedback::feedback(const std::string &guess, const std::string &solution) {
+namespace {
+
+constexpr int gray = 0;
+constexpr int yellow = 1;
+constexpr int green = 2;
+
+/// weight of the base-3 digit of each position, first position first
+template <int N> constexpr auto digit_weights = [] {
+  std::array<int, N> weights{};
+  int weight{1};
+  for (int i = N - 1; i >= 0; --i) {
+    weights[i] = weight;
+    weight *= 3;
+  }
+  return weights;
+}();
+
+} // namespace
+
+template <int N, typename Alphabet>
+auto BasicFeedback<N, Alphabet>::feedback(const std::string &guess,
+                                          const std::string &solution)
+    -> Code {
   Code code;
-  for (int i = 0; i < WordleSolver::word_len; ++i) {
-    set_bits(&code, feedback_element(guess[i], solution[i], solution), i);
+  const auto colors = pattern(guess, solution);
+  for (int i = 0; i < N; ++i) {
+    set_bits(&code, Code_element(colors / digit_weights<N>[i] % 3), i);
   }
   return code;
 }
 
-std::string Feedback::feedback_string(const std::string &guess,
-                                      const std::string &solution) {
-  std::string outcome;
-  for (int i = 0; i < WordleSolver::word_len; ++i) {
-    outcome += feedback_element_char(guess[i], solution[i], solution);
-  }
-  return outcome;
+template <int N, typename Alphabet>
+auto BasicFeedback<N, Alphabet>::pattern(const std::string &guess,
+                                         const std::string &solution)
+    -> Pattern {
+  return pattern(PackedWord::parse(guess), PackedWord::parse(solution));
 }
 
-void Feedback::set_bits(Code *target, const Code_element source,
-                        const std::size_t section) {
-  const auto index = (target->size() - 1) - (section * 2);
-  target->set(index, source[1]);
-  target->set(index - 1, source[0]);
-}
+template <int N, typename Alphabet>
+auto BasicFeedback<N, Alphabet>::pattern(const PackedWord guess,
+                                         const PackedWord solution)
+    -> Pattern {
+  constexpr int len = N;
 
-Code_element Feedback::feedback_element(const char ch_test,
-                                        const char ch_solution,
-                                        const std::string &solution) {
-  Code_element code_elem{};
-  const bool not_in_solution =
-      (std::find(solution.begin(), solution.end(), ch_test) == solution.end());
-  if (not_in_solution) {
-    return code_elem;
+  if ((guess.mask() & solution.mask()) == 0) {
+    return 0;
   }
-  if (ch_test == ch_solution) {
-    code_elem.set(1);
-    return code_elem;
+
+  std::array<int, len> guess_letters{};
+  std::array<int, len> solution_letters{};
+  std::array<bool, len> is_green{};
+  for (int i = 0; i < len; ++i) {
+    guess_letters[i] = guess.letter(i);
+    solution_letters[i] = solution.letter(i);
+    is_green[i] = guess_letters[i] == solution_letters[i];
   }
-  code_elem.set(0);
-  return code_elem;
+
+  // A guess letter is yellow while the solution has more unmatched copies of
+  // it than the guess has already used up further left.
+  int code{};
+  for (int i = 0; i < len; ++i) {
+    int unmatched{};
+    for (int k = 0; k < len; ++k) {
+      unmatched += static_cast<int>(!is_green[k] &&
+                                    solution_letters[k] == guess_letters[i]);
+    }
+    int used{};
+    for (int j = 0; j < i; ++j) {
+      used += static_cast<int>(!is_green[j] &&
+                               guess_letters[j] == guess_letters[i]);
+    }
+    const int digit = is_green[i]            ? green
+                      : (unmatched > used) ? yellow
+                                             : gray;
+    code += digit * digit_weights<N>[i];
+  }
+  return static_cast<Pattern>(code);
+}
+
+template <int N, typename Alphabet>
+std::string
+BasicFeedback<N, Alphabet>::feedback_string(const std::string &guess,
+                                            const std::string &solution) {
+  return to_string(pattern(guess, solution));
 }
 
-char Feedback::feedback_element_char(const char ch_test, const char ch_solution,
-                                     const std::string &solution) {
-  const bool not_in_solution =
-      (std::find(solution.begin(), solution.end(), ch_test) == solution.end());
-  if (not_in_solution) {
-    return 'x';
+template <int N, typename Alphabet>
+std::string BasicFeedback<N, Alphabet>::to_string(const Pattern pattern) {
+  std::string outcome(N, 'x');
+  for (int i = 0; i < N; ++i) {
+    switch (pattern / digit_weights<N>[i] % 3) {
+    case yellow: outcome[i] = 'y'; break;
+    case green: outcome[i] = 'g'; break;
+    default:;
+    }
   }
-  if (ch_test == ch_solution) {
-    return 'g';
+  return outcome;
+}
+
+template <int N, typename Alphabet>
+auto BasicFeedback<N, Alphabet>::to_pattern(const std::string &feedback)
+    -> Pattern {
+  int code{};
+  const auto len = std::min(static_cast<std::size_t>(N), feedback.size());
+  for (std::size_t i = 0; i < len; ++i) {
+    switch (feedback[i]) {
+    case 'y': code += yellow * digit_weights<N>[i]; break;
+    case 'g': code += green * digit_weights<N>[i]; break;
+    default:;
+    }
   }
-  return 'y';
+  return static_cast<Pattern>(code);
 }
+
+template <int N, typename Alphabet>
+void BasicFeedback<N, Alphabet>::set_bits(Code *target,
+                                          const Code_element source,
+                                          const std::size_t section) {
+  const auto index = (target->size() - 1) - (section * 2);
+  target->set(index, source[1]);
+  target->set(index - 1, source[0]);
+}
+
+template class BasicFeedback<4>;
+template class BasicFeedback<5>;
+template class BasicFeedback<6>;
+template class BasicFeedback<7>;
+template class BasicFeedback<8>;
@@ -0,0 +1,273 @@
+#include "feedback_batch.h"
+
+#include <array>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                              \
+    (defined(__x86_64__) || defined(__i386__))
+#define WORDLE_SOLVER_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// All kernels use the same rule as Feedback::pattern: letter i is green on
+// an exact match, otherwise yellow if the solution's unmatched copies of it
+// outnumber the non-green copies earlier in the guess.
+
+template <int N, typename Alphabet>
+void patterns_scalar(const BasicPackedWord<N, Alphabet> guess,
+                     const BasicSolutionBlock<N, Alphabet> &block,
+                     typename BasicFeedback<N, Alphabet>::Pattern *out) {
+  constexpr int word_len = N;
+  using Pattern = typename BasicFeedback<N, Alphabet>::Pattern;
+  for (std::size_t lane = 0; lane < block.size(); ++lane) {
+    bool green[word_len];
+    for (int k = 0; k < word_len; ++k) {
+      green[k] = block.letters(k)[lane] == guess.letter(k);
+    }
+    int code{};
+    for (int i = 0; i < word_len; ++i) {
+      const auto letter = guess.letter(i);
+      int unmatched{};
+      for (int k = 0; k < word_len; ++k) {
+        unmatched +=
+            static_cast<int>(!green[k] && block.letters(k)[lane] == letter);
+      }
+      int used{};
+      for (int j = 0; j < i; ++j) {
+        used += static_cast<int>(!green[j] && guess.letter(j) == letter);
+      }
+      const int yellow = static_cast<int>(!green[i] && unmatched > used);
+      code = code * 3 + 2 * static_cast<int>(green[i]) + yellow;
+    }
+    out[lane] = static_cast<Pattern>(code);
+  }
+}
+
+#ifdef WORDLE_SOLVER_X86_KERNELS
+
+// The vector kernels keep a pattern in a byte, so they serve up to five
+// letters.
+
+template <int N, typename Alphabet>
+__attribute__((target("avx2"))) void
+patterns_avx2(const BasicPackedWord<N, Alphabet> guess,
+              const BasicSolutionBlock<N, Alphabet> &block,
+              std::uint8_t *out) {
+  constexpr int word_len = N;
+  using Pattern = std::uint8_t;
+  constexpr std::size_t width = 32;
+  __m256i guess_letters[word_len];
+  for (int i = 0; i < word_len; ++i) {
+    guess_letters[i] = _mm256_set1_epi8(static_cast<char>(guess.letter(i)));
+  }
+  const __m256i one = _mm256_set1_epi8(1);
+  const __m256i two = _mm256_set1_epi8(2);
+
+  for (std::size_t base = 0; base < block.size(); base += width) {
+    __m256i letters[word_len];
+    for (int k = 0; k < word_len; ++k) {
+      letters[k] = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(block.letters(k) + base));
+    }
+    __m256i green[word_len];
+    for (int k = 0; k < word_len; ++k) {
+      green[k] = _mm256_cmpeq_epi8(letters[k], guess_letters[k]);
+    }
+    __m256i code = _mm256_setzero_si256();
+    for (int i = 0; i < word_len; ++i) {
+      // comparison masks are -1, so subtracting them counts
+      __m256i unmatched = _mm256_setzero_si256();
+      for (int k = 0; k < word_len; ++k) {
+        unmatched = _mm256_sub_epi8(
+            unmatched,
+            _mm256_andnot_si256(
+                green[k], _mm256_cmpeq_epi8(letters[k], guess_letters[i])));
+      }
+      __m256i used = _mm256_setzero_si256();
+      for (int j = 0; j < i; ++j) {
+        if (guess.letter(j) == guess.letter(i)) {
+          used = _mm256_add_epi8(used, _mm256_andnot_si256(green[j], one));
+        }
+      }
+      const __m256i yellow = _mm256_andnot_si256(
+          green[i], _mm256_cmpgt_epi8(unmatched, used));
+      const __m256i digit = _mm256_or_si256(_mm256_and_si256(green[i], two),
+                                            _mm256_and_si256(yellow, one));
+      code = _mm256_add_epi8(_mm256_add_epi8(code, code),
+                             _mm256_add_epi8(code, digit));
+    }
+    if (base + width <= block.size()) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + base), code);
+    } else {
+      std::array<Pattern, width> tail{};
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(tail.data()), code);
+      std::memcpy(out + base, tail.data(), block.size() - base);
+    }
+  }
+}
+
+template <int N, typename Alphabet>
+__attribute__((target("sse4.2"))) void
+patterns_sse42(const BasicPackedWord<N, Alphabet> guess,
+               const BasicSolutionBlock<N, Alphabet> &block,
+               std::uint8_t *out) {
+  constexpr int word_len = N;
+  using Pattern = std::uint8_t;
+  constexpr std::size_t width = 16;
+  __m128i guess_letters[word_len];
+  for (int i = 0; i < word_len; ++i) {
+    guess_letters[i] = _mm_set1_epi8(static_cast<char>(guess.letter(i)));
+  }
+  const __m128i one = _mm_set1_epi8(1);
+  const __m128i two = _mm_set1_epi8(2);
+
+  for (std::size_t base = 0; base < block.size(); base += width) {
+    __m128i letters[word_len];
+    for (int k = 0; k < word_len; ++k) {
+      letters[k] = _mm_loadu_si128(
+          reinterpret_cast<const __m128i *>(block.letters(k) + base));
+    }
+    __m128i green[word_len];
+    for (int k = 0; k < word_len; ++k) {
+      green[k] = _mm_cmpeq_epi8(letters[k], guess_letters[k]);
+    }
+    __m128i code = _mm_setzero_si128();
+    for (int i = 0; i < word_len; ++i) {
+      __m128i unmatched = _mm_setzero_si128();
+      for (int k = 0; k < word_len; ++k) {
+        unmatched = _mm_sub_epi8(
+            unmatched, _mm_andnot_si128(green[k], _mm_cmpeq_epi8(
+                                                      letters[k],
+                                                      guess_letters[i])));
+      }
+      __m128i used = _mm_setzero_si128();
+      for (int j = 0; j < i; ++j) {
+        if (guess.letter(j) == guess.letter(i)) {
+          used = _mm_add_epi8(used, _mm_andnot_si128(green[j], one));
+        }
+      }
+      const __m128i yellow =
+          _mm_andnot_si128(green[i], _mm_cmpgt_epi8(unmatched, used));
+      const __m128i digit = _mm_or_si128(_mm_and_si128(green[i], two),
+                                         _mm_and_si128(yellow, one));
+      code = _mm_add_epi8(_mm_add_epi8(code, code), _mm_add_epi8(code, digit));
+    }
+    if (base + width <= block.size()) {
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + base), code);
+    } else {
+      std::array<Pattern, width> tail{};
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(tail.data()), code);
+      std::memcpy(out + base, tail.data(), block.size() - base);
+    }
+  }
+}
+
+#endif // WORDLE_SOLVER_X86_KERNELS
+
+} // namespace
+
+template <int N, typename Alphabet>
+BasicSolutionBlock<N, Alphabet>::BasicSolutionBlock(
+    const BasicWordList<N, Alphabet> &solutions)
+    : _size{solutions.size()},
+      _padded_size{(solutions.size() + lane_count - 1) / lane_count *
+                   lane_count},
+      _letters(_padded_size * N) {
+  for (std::size_t lane = 0; lane < _size; ++lane) {
+    for (int i = 0; i < N; ++i) {
+      _letters[i * _padded_size + lane] =
+          static_cast<std::uint8_t>(solutions[lane].letter(i));
+    }
+  }
+}
+
+FeedbackBatch::Isa FeedbackBatch::best_isa() {
+#ifdef WORDLE_SOLVER_X86_KERNELS
+  static const Isa isa = [] {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+      return Isa::avx2;
+    }
+    if (__builtin_cpu_supports("sse4.2")) {
+      return Isa::sse42;
+    }
+    return Isa::scalar;
+  }();
+  return isa;
+#else
+  return Isa::scalar;
+#endif
+}
+
+const char *FeedbackBatch::isa_name(const Isa isa) {
+  switch (isa) {
+  case Isa::avx2: return "avx2";
+  case Isa::sse42: return "sse4.2";
+  case Isa::scalar: return "scalar";
+  }
+  return "unknown";
+}
+
+template <int N, typename Alphabet>
+void FeedbackBatch::patterns(
+    const BasicPackedWord<N, Alphabet> guess,
+    const BasicSolutionBlock<N, Alphabet> &block,
+    typename BasicFeedback<N, Alphabet>::Pattern *out) {
+  patterns(guess, block, out, best_isa());
+}
+
+template <int N, typename Alphabet>
+void FeedbackBatch::patterns(
+    const BasicPackedWord<N, Alphabet> guess,
+    const BasicSolutionBlock<N, Alphabet> &block,
+    typename BasicFeedback<N, Alphabet>::Pattern *out, const Isa isa) {
+#ifdef WORDLE_SOLVER_X86_KERNELS
+  if constexpr (sizeof(*out) == 1) {
+    switch (isa) {
+    case Isa::avx2: patterns_avx2(guess, block, out); return;
+    case Isa::sse42: patterns_sse42(guess, block, out); return;
+    default: break;
+    }
+  }
+#endif
+  static_cast<void>(isa);
+  patterns_scalar(guess, block, out);
+}
+
+template class BasicSolutionBlock<4>;
+template class BasicSolutionBlock<5>;
+template class BasicSolutionBlock<6>;
+template class BasicSolutionBlock<7>;
+template class BasicSolutionBlock<8>;
+template void FeedbackBatch::patterns(BasicPackedWord<4>,
+                                      const BasicSolutionBlock<4> &,
+                                      BasicFeedback<4>::Pattern *);
+template void FeedbackBatch::patterns(BasicPackedWord<4>,
+                                      const BasicSolutionBlock<4> &,
+                                      BasicFeedback<4>::Pattern *, Isa);
+template void FeedbackBatch::patterns(BasicPackedWord<5>,
+                                      const BasicSolutionBlock<5> &,
+                                      BasicFeedback<5>::Pattern *);
+template void FeedbackBatch::patterns(BasicPackedWord<5>,
+                                      const BasicSolutionBlock<5> &,
+                                      BasicFeedback<5>::Pattern *, Isa);
+template void FeedbackBatch::patterns(BasicPackedWord<6>,
+                                      const BasicSolutionBlock<6> &,
+                                      BasicFeedback<6>::Pattern *);
+template void FeedbackBatch::patterns(BasicPackedWord<6>,
+                                      const BasicSolutionBlock<6> &,
+                                      BasicFeedback<6>::Pattern *, Isa);
+template void FeedbackBatch::patterns(BasicPackedWord<7>,
+                                      const BasicSolutionBlock<7> &,
+                                      BasicFeedback<7>::Pattern *);
+template void FeedbackBatch::patterns(BasicPackedWord<7>,
+                                      const BasicSolutionBlock<7> &,
+                                      BasicFeedback<7>::Pattern *, Isa);
+template void FeedbackBatch::patterns(BasicPackedWord<8>,
+                                      const BasicSolutionBlock<8> &,
+                                      BasicFeedback<8>::Pattern *);
+template void FeedbackBatch::patterns(BasicPackedWord<8>,
+                                      const BasicSolutionBlock<8> &,
+                                      BasicFeedback<8>::Pattern *, Isa);
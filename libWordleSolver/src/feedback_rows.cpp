@@ -0,0 +1,102 @@
+#include "feedback_rows.h"
+
+template <int N, typename Alphabet>
+BasicFeedbackRows<N, Alphabet>::Candidates::Candidates(
+    const std::uint64_t fingerprint, const WordList &all_solutions,
+    const std::vector<std::uint32_t> &indices)
+    : _key{GuessCache::key(fingerprint, indices)} {
+  WordList words;
+  for (const auto index : indices) {
+    words.push_back(all_solutions[index]);
+  }
+  _block = BasicSolutionBlock<N, Alphabet>{words};
+}
+
+template <int N, typename Alphabet>
+BasicFeedbackRows<N, Alphabet>::BasicFeedbackRows(const std::size_t budget)
+    : _budget{budget}, _shard_budget{budget / shard_count} {}
+
+template <int N, typename Alphabet>
+void BasicFeedbackRows<N, Alphabet>::count(const Candidates &candidates,
+                                           const std::uint32_t row,
+                                           const PackedWord guess,
+                                           PatternHistogram *histogram) const {
+  const Key key{candidates._key, row};
+  const auto bytes = entry_bytes(candidates.size());
+  const bool keep =
+      candidates.size() >= min_kept_row && bytes <= _shard_budget;
+  auto &shard = _shards[key.candidates.second % shard_count];
+  if (keep) {
+    Row found;
+    {
+      const std::lock_guard lock(shard.mutex);
+      if (const auto entry = shard.index.find(key);
+          entry != shard.index.end()) {
+        shard.entries.splice(shard.entries.begin(), shard.entries,
+                             entry->second);
+        found = entry->second->second;
+      }
+    }
+    if (found) {
+      ++_hits;
+      for (const auto pattern : *found) {
+        histogram->add(pattern);
+      }
+      return;
+    }
+  }
+  ++_misses;
+
+  // computed outside the lock; another solver may compute the same row
+  thread_local std::vector<Pattern> patterns;
+  patterns.resize(candidates.size());
+  FeedbackBatch::patterns(guess, candidates._block, patterns.data());
+  for (const auto pattern : patterns) {
+    histogram->add(pattern);
+  }
+  if (!keep) {
+    return;
+  }
+
+  auto kept = std::make_shared<const std::vector<Pattern>>(patterns);
+  const std::lock_guard lock(shard.mutex);
+  if (shard.index.count(key) != 0) {
+    return;
+  }
+  while (shard.bytes + bytes > _shard_budget) {
+    shard.bytes -= entry_bytes(shard.entries.back().second->size());
+    shard.index.erase(shard.entries.back().first);
+    shard.entries.pop_back();
+    ++_evictions;
+  }
+  shard.entries.emplace_front(key, std::move(kept));
+  shard.index.emplace(key, shard.entries.begin());
+  shard.bytes += bytes;
+}
+
+template <int N, typename Alphabet>
+void BasicFeedbackRows<N, Alphabet>::clear() {
+  for (auto &shard : _shards) {
+    const std::lock_guard lock(shard.mutex);
+    shard.entries.clear();
+    shard.index.clear();
+    shard.bytes = 0;
+  }
+}
+
+template <int N, typename Alphabet>
+auto BasicFeedbackRows<N, Alphabet>::statistics() const -> Statistics {
+  Statistics statistics{_hits, _misses, _evictions, 0, 0, _budget};
+  for (auto &shard : _shards) {
+    const std::lock_guard lock(shard.mutex);
+    statistics.rows += shard.entries.size();
+    statistics.bytes += shard.bytes;
+  }
+  return statistics;
+}
+
+template class BasicFeedbackRows<4>;
+template class BasicFeedbackRows<5>;
+template class BasicFeedbackRows<6>;
+template class BasicFeedbackRows<7>;
+template class BasicFeedbackRows<8>;
@@ -0,0 +1,74 @@
+#include "guess_cache.h"
+
+#include <stdexcept>
+
+GuessCache::GuessCache(const std::size_t capacity)
+    : _capacity{capacity},
+      _shard_capacity{(capacity + shard_count - 1) / shard_count} {
+  if (capacity == 0) {
+    throw std::invalid_argument("a guess cache needs room for an entry");
+  }
+}
+
+GuessCache::Key
+GuessCache::key(const std::uint64_t settings,
+                const std::vector<std::uint32_t> &candidates) {
+  // FNV-1a, and a multiply-xorshift mix, as for the decision tree's memo
+  Key key{0xcbf29ce484222325 ^ settings,
+          settings + static_cast<std::uint64_t>(candidates.size())};
+  for (const auto index : candidates) {
+    key.first = (key.first ^ index) * 0x100000001b3;
+    key.second = (key.second + index + 1) * 0x9e3779b97f4a7c15;
+    key.second ^= key.second >> 29U;
+  }
+  return key;
+}
+
+std::optional<std::uint32_t> GuessCache::find(const Key &key) {
+  auto &shard = _shards[key.second % shard_count];
+  const std::lock_guard lock(shard.mutex);
+  const auto found = shard.index.find(key);
+  if (found == shard.index.end()) {
+    ++_misses;
+    return std::nullopt;
+  }
+  ++_hits;
+  shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+  return found->second->second;
+}
+
+void GuessCache::insert(const Key &key, const std::uint32_t row) {
+  auto &shard = _shards[key.second % shard_count];
+  const std::lock_guard lock(shard.mutex);
+  // another solver may have searched the same candidates meanwhile
+  if (const auto found = shard.index.find(key); found != shard.index.end()) {
+    found->second->second = row;
+    shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+    return;
+  }
+  if (shard.entries.size() >= _shard_capacity) {
+    shard.index.erase(shard.entries.back().first);
+    shard.entries.pop_back();
+    ++_evictions;
+  }
+  shard.entries.emplace_front(key, row);
+  shard.index.emplace(key, shard.entries.begin());
+  ++_insertions;
+}
+
+void GuessCache::clear() {
+  for (auto &shard : _shards) {
+    const std::lock_guard lock(shard.mutex);
+    shard.entries.clear();
+    shard.index.clear();
+  }
+}
+
+GuessCache::Statistics GuessCache::statistics() const {
+  Statistics statistics{_hits, _misses, _insertions, _evictions, 0};
+  for (auto &shard : _shards) {
+    const std::lock_guard lock(shard.mutex);
+    statistics.size += shard.entries.size();
+  }
+  return statistics;
+}
@@ -0,0 +1,61 @@
+#include "mapped_file.h"
+
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string &file_name) {
+  const int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file " + file_name);
+  }
+  struct stat status {};
+  if (::fstat(fd, &status) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to read file " + file_name);
+  }
+  _size = static_cast<std::size_t>(status.st_size);
+  if (_size != 0) {
+    void *address = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Failed to map file " + file_name);
+    }
+    _data = static_cast<const std::byte *>(address);
+  }
+  // the mapping stays valid after the descriptor is closed
+  ::close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (_data != nullptr) {
+    ::munmap(const_cast<std::byte *>(_data), _size);
+  }
+}
+
+#else
+#include <fstream>
+
+MappedFile::MappedFile(const std::string &file_name) {
+  std::ifstream in(file_name, std::ios::binary | std::ios::ate);
+  if (!in.is_open()) {
+    throw std::runtime_error("Failed to open file " + file_name);
+  }
+  _buffer.resize(static_cast<std::size_t>(in.tellg()));
+  in.seekg(0);
+  in.read(reinterpret_cast<char *>(_buffer.data()),
+          static_cast<std::streamsize>(_buffer.size()));
+  if (!in) {
+    throw std::runtime_error("Failed to read file " + file_name);
+  }
+  _data = _buffer.data();
+  _size = _buffer.size();
+}
+
+MappedFile::~MappedFile() = default;
+
+#endif
@@ -0,0 +1,227 @@
+#include "multi_board_solver.h"
+
+#include "dictionary.h"
+#include "entropy_bound.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+using Best = std::pair<double, std::size_t>; // score, order position
+
+/// small chunks keep the threads busy until the end of the list
+constexpr std::size_t grain{32};
+
+/// the higher score, or on a tie the earlier position, so results don't
+/// depend on how the list was split between threads
+Best better(const Best &lhs, const Best &rhs) {
+  if (lhs.first != rhs.first) {
+    return lhs.first > rhs.first ? lhs : rhs;
+  }
+  return lhs.second < rhs.second ? lhs : rhs;
+}
+
+} // namespace
+
+template <int N, typename Alphabet>
+BasicMultiBoardSolver<N, Alphabet>::BasicMultiBoardSolver(
+    std::shared_ptr<const Dictionary> dictionary, const std::size_t boards)
+    : _dictionary{std::move(dictionary)}, _pool{ThreadPool::shared()},
+      _boards(boards) {
+  if (boards == 0) {
+    throw std::invalid_argument("a multi-board game needs a board");
+  }
+  if (!_dictionary->has_table()) {
+    throw std::invalid_argument("a multi-board game needs a pattern table");
+  }
+  reset();
+}
+
+template <int N, typename Alphabet>
+void BasicMultiBoardSolver<N, Alphabet>::reset() {
+  for (auto &board : _boards) {
+    board.constraints = Constraints{};
+    board.candidates.resize(_dictionary->all_solutions().size());
+    std::iota(board.candidates.begin(), board.candidates.end(), 0);
+    board.solved = false;
+  }
+  _first_turn = true;
+}
+
+template <int N, typename Alphabet>
+void BasicMultiBoardSolver<N, Alphabet>::set_thread_count(
+    const unsigned thread_count) {
+  _pool = std::make_shared<ThreadPool>(std::max(1U, thread_count));
+}
+
+template <int N, typename Alphabet>
+void BasicMultiBoardSolver<N, Alphabet>::set_thread_pool(
+    std::shared_ptr<ThreadPool> pool) {
+  _pool = std::move(pool);
+}
+
+template <int N, typename Alphabet>
+bool BasicMultiBoardSolver<N, Alphabet>::all_solved() const {
+  return std::all_of(_boards.begin(), _boards.end(),
+                     [](const Board &board) { return board.solved; });
+}
+
+template <int N, typename Alphabet>
+std::string BasicMultiBoardSolver<N, Alphabet>::guess() {
+  for (std::size_t index = 0; index < _boards.size(); ++index) {
+    const auto &board = _boards[index];
+    if (!board.solved && board.candidates.empty()) {
+      throw std::runtime_error("no word fits the feedback on board " +
+                               std::to_string(index + 1));
+    }
+  }
+
+  // a board with one candidate left is solved for certain by guessing it
+  const auto single = std::find_if(
+      _boards.begin(), _boards.end(), [](const Board &board) {
+        return !board.solved && board.candidates.size() == 1;
+      });
+  if (single != _boards.end()) {
+    _last_guess = _dictionary->all_solutions()[single->candidates[0]];
+  } else {
+    _last_guess = _dictionary->patterns().guesses()[best_row()];
+  }
+  _first_turn = false;
+  return _last_guess.to_string();
+}
+
+template <int N, typename Alphabet>
+void BasicMultiBoardSolver<N, Alphabet>::accept_feedback(
+    const std::vector<std::string> &feedback) {
+  if (feedback.size() != _boards.size()) {
+    throw std::invalid_argument("expected feedback for " +
+                                std::to_string(_boards.size()) + " boards");
+  }
+  constexpr auto solved = Feedback::pattern_count - 1;
+  for (std::size_t index = 0; index < _boards.size(); ++index) {
+    auto &board = _boards[index];
+    if (board.solved) {
+      continue;
+    }
+    const auto pattern = Feedback::to_pattern(feedback[index]);
+    if (pattern == solved) {
+      board.solved = true;
+      board.candidates.clear();
+      continue;
+    }
+    board.constraints.add(_last_guess, pattern);
+    board.constraints.filter(_dictionary->all_solutions(),
+                             &board.candidates);
+  }
+}
+
+template <int N, typename Alphabet>
+auto BasicMultiBoardSolver<N, Alphabet>::groups() const -> std::vector<Group> {
+  // Boards with the same candidates score the same, so they're scored once.
+  // On the first turn that makes every board one group.
+  std::vector<Group> groups;
+  for (const auto &board : _boards) {
+    if (board.solved) {
+      continue;
+    }
+    const auto same = std::find_if(
+        groups.begin(), groups.end(), [&board](const Group &group) {
+          return *group.candidates == board.candidates;
+        });
+    if (same != groups.end()) {
+      ++same->weight;
+    } else {
+      groups.push_back(Group{&board.candidates, 1.0});
+    }
+  }
+  return groups;
+}
+
+template <int N, typename Alphabet>
+std::uint32_t BasicMultiBoardSolver<N, Alphabet>::best_row() {
+  // Rounding may put a bound a hair under a score it equals; the margin
+  // keeps such a word, which could still win a tie on position.
+  constexpr double margin{1e-9};
+
+  const auto &patterns = _dictionary->patterns();
+  std::vector<std::uint32_t> rows;
+  if (_first_turn) {
+    rows.resize(patterns.guesses().size());
+    std::iota(rows.begin(), rows.end(), 0);
+  } else {
+    rows = patterns.solution_rows();
+  }
+
+  // the sum of the boards' EntropyBound caps the summed entropy
+  const auto groups = this->groups();
+  std::vector<BasicEntropyBound<N, Alphabet>> bounds;
+  bounds.reserve(groups.size());
+  for (const auto &group : groups) {
+    bounds.emplace_back(_dictionary->all_solutions(), *group.candidates);
+  }
+  std::vector<std::pair<double, std::uint32_t>> order; // bound, row
+  order.reserve(rows.size());
+  for (const auto row : rows) {
+    double bound{};
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+      bound += groups[g].weight * bounds[g](patterns.guesses()[row]);
+    }
+    order.emplace_back(bound, row);
+  }
+  std::sort(order.begin(), order.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.first != rhs.first ? lhs.first > rhs.first
+                                  : lhs.second < rhs.second;
+  });
+
+  // the best score found so far by any thread
+  std::atomic<double> running{std::numeric_limits<double>::lowest()};
+  std::atomic<std::uint64_t> skipped{};
+  const auto [score, position] = _pool->parallel_reduce(
+      order.size(), grain, Best{std::numeric_limits<double>::lowest(), 0},
+      [this, &order, &groups, &running, &skipped](
+          const std::size_t first, const std::size_t last, Best &best) {
+        for (auto k = first; k < last; ++k) {
+          // the order is by bound, so nothing after this can win either
+          if (order[k].first + margin < running.load()) {
+            skipped += last - k;
+            return;
+          }
+          const double score = get_score(order[k].second, groups);
+          best = better(best, Best{score, k});
+          auto seen = running.load();
+          while (score > seen && !running.compare_exchange_weak(seen, score)) {
+          }
+        }
+      },
+      better);
+  _skipped_evaluations += skipped;
+
+  return order[position].second;
+}
+
+template <int N, typename Alphabet>
+double
+BasicMultiBoardSolver<N, Alphabet>::get_score(const std::uint32_t row,
+                                              const std::vector<Group> &groups)
+    const {
+  const auto *patterns = _dictionary->patterns().row(row);
+  double score{};
+  for (const auto &group : groups) {
+    PatternHistogram histogram;
+    histogram.count(patterns, group.candidates->begin(),
+                    group.candidates->end());
+    score += group.weight * histogram.entropy();
+  }
+  return score;
+}
+
+template class BasicMultiBoardSolver<4>;
+template class BasicMultiBoardSolver<5>;
+template class BasicMultiBoardSolver<6>;
+template class BasicMultiBoardSolver<7>;
+template class BasicMultiBoardSolver<8>;
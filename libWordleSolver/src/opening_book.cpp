@@ -0,0 +1,216 @@
+#include "opening_book.h"
+
+#include "dictionary.h"
+#include "thread_pool.h"
+#include "wordle_solver.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::array<char, 8> magic{'W', 'S', 'B', 'O', 'O', 'K', '\0', '\0'};
+constexpr std::uint32_t version{1};
+
+/// the pattern of a guess that solves the puzzle
+template <typename Feedback>
+constexpr auto solved =
+    static_cast<typename Feedback::Pattern>(Feedback::pattern_count - 1);
+
+/// a history the builder has reached, with the solver that reached it
+template <int N, typename Alphabet> struct Node {
+  typename BasicOpeningBook<N, Alphabet>::History history;
+  BasicWordleSolver<N, Alphabet> solver;
+  std::vector<std::uint32_t> candidates; ///< all_solutions indices
+  BasicPackedWord<N, Alphabet> guess;
+};
+
+template <typename T> void write(std::ofstream &out, const T &value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T> auto read(std::ifstream &in) -> T {
+  T value{};
+  in.read(reinterpret_cast<char *>(&value), sizeof(value));
+  return value;
+}
+
+} // namespace
+
+template <int N, typename Alphabet>
+std::uint64_t BasicOpeningBook<N, Alphabet>::key(const History &history) {
+  // base pattern_count + 1, so that a leading gray-gray-gray-gray-gray
+  // pattern still makes a different key from the shorter history
+  std::uint64_t key{};
+  std::uint64_t weight{1};
+  for (const auto pattern : history) {
+    key += (static_cast<std::uint64_t>(pattern) + 1) * weight;
+    weight *= Feedback::pattern_count + 1;
+  }
+  return key;
+}
+
+template <int N, typename Alphabet>
+auto BasicOpeningBook<N, Alphabet>::find(const History &history) const
+    -> std::optional<PackedWord> {
+  if (history.size() >= static_cast<std::size_t>(_depth)) {
+    return std::nullopt;
+  }
+  const auto wanted = key(history);
+  const auto entry = std::lower_bound(
+      _entries.begin(), _entries.end(), wanted,
+      [](const Entry &lhs, const std::uint64_t rhs) {
+        return lhs.first < rhs;
+      });
+  if (entry == _entries.end() || entry->first != wanted) {
+    return std::nullopt;
+  }
+  return PackedWord::from_key(entry->second);
+}
+
+template <int N, typename Alphabet>
+auto BasicOpeningBook<N, Alphabet>::build(
+    std::shared_ptr<const Dictionary> dictionary, const int depth)
+    -> std::shared_ptr<const BasicOpeningBook> {
+  using Node = ::Node<N, Alphabet>;
+  if (depth < 1 || depth > max_depth) {
+    throw std::invalid_argument("opening book depth must be 1 to " +
+                                std::to_string(max_depth));
+  }
+  if (!dictionary->has_table()) {
+    throw std::invalid_argument("an opening book needs a pattern table");
+  }
+  auto book = std::make_shared<BasicOpeningBook>();
+  book->_depth = depth;
+  book->_fingerprint = dictionary->fingerprint();
+
+  const auto &patterns = dictionary->patterns();
+  const auto pool = ThreadPool::shared();
+
+  std::vector<Node> level;
+  {
+    Node root{{}, BasicWordleSolver<N, Alphabet>{dictionary}, {}, {}};
+    root.solver.set_thread_count(1);
+    root.candidates.resize(dictionary->all_solutions().size());
+    for (std::uint32_t i = 0; i < root.candidates.size(); ++i) {
+      root.candidates[i] = i;
+    }
+    root.guess = PackedWord{root.solver.guess()};
+    level.push_back(std::move(root));
+  }
+
+  for (int turn = 1;; ++turn) {
+    for (const auto &node : level) {
+      book->_entries.emplace_back(key(node.history), node.guess.key());
+    }
+    if (turn == depth) {
+      break;
+    }
+
+    // every feedback that leaves more than one candidate needs a guess; the
+    // solver finds the last one without any searching
+    std::vector<Node> next;
+    for (const auto &node : level) {
+      const auto *row = patterns.row(patterns.guesses().index_of(node.guess));
+      std::array<std::vector<std::uint32_t>, Feedback::pattern_count> buckets;
+      for (const auto index : node.candidates) {
+        buckets[row[index]].push_back(index);
+      }
+      for (std::size_t pattern = 0; pattern < buckets.size(); ++pattern) {
+        if (pattern == solved<Feedback> || buckets[pattern].size() < 2) {
+          continue;
+        }
+        auto history = node.history;
+        history.push_back(static_cast<typename Feedback::Pattern>(pattern));
+        next.push_back(Node{std::move(history), node.solver,
+                            std::move(buckets[pattern]), {}});
+      }
+    }
+    pool->parallel_for(
+        next.size(), 1,
+        [&next](const std::size_t first, const std::size_t last) {
+          for (auto i = first; i < last; ++i) {
+            auto &node = next[i];
+            node.solver.accept_feedback(
+                Feedback::to_string(node.history.back()));
+            node.guess = PackedWord{node.solver.guess()};
+          }
+        });
+    level = std::move(next);
+  }
+
+  std::sort(book->_entries.begin(), book->_entries.end());
+  return book;
+}
+
+template <int N, typename Alphabet>
+void BasicOpeningBook<N, Alphabet>::save(const std::string &file_name) const {
+  std::ofstream out(file_name, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) {
+    throw std::runtime_error("Failed to open file " + file_name);
+  }
+  out.write(magic.data(), magic.size());
+  write(out, version);
+  write(out, static_cast<std::uint32_t>(_depth));
+  write(out, _fingerprint);
+  write(out, static_cast<std::uint64_t>(_entries.size()));
+  for (const auto &[history, guess] : _entries) {
+    write(out, history);
+    write(out, guess);
+  }
+  if (!out) {
+    throw std::runtime_error("Failed to write file " + file_name);
+  }
+}
+
+template <int N, typename Alphabet>
+auto BasicOpeningBook<N, Alphabet>::load(const std::string &file_name,
+                                         const Dictionary &dictionary)
+    -> std::shared_ptr<const BasicOpeningBook> {
+  std::ifstream in(file_name, std::ios::binary);
+  if (!in.is_open()) {
+    throw std::runtime_error("Failed to open file " + file_name);
+  }
+  std::array<char, magic.size()> header{};
+  in.read(header.data(), header.size());
+  if (!in || header != magic || read<std::uint32_t>(in) != version) {
+    throw std::runtime_error(file_name + " is not an opening book");
+  }
+
+  auto book = std::make_shared<BasicOpeningBook>();
+  book->_depth = static_cast<int>(read<std::uint32_t>(in));
+  book->_fingerprint = read<std::uint64_t>(in);
+  const auto count = read<std::uint64_t>(in);
+  if (!in || book->_depth < 1 || book->_depth > max_depth) {
+    throw std::runtime_error(file_name + " is not an opening book");
+  }
+  if (book->_fingerprint != dictionary.fingerprint()) {
+    throw std::runtime_error(file_name +
+                             " was built for a different dictionary");
+  }
+
+  const auto &all_words = dictionary.all_words();
+  const auto &all_solutions = dictionary.all_solutions();
+  for (std::uint64_t i = 0; i < count && in; ++i) {
+    const auto history = read<std::uint64_t>(in);
+    const auto guess = read<typename PackedWord::Key>(in);
+    const auto word = PackedWord::from_key(guess);
+    if (all_words.index_of(word) == all_words.npos &&
+        all_solutions.index_of(word) == all_solutions.npos) {
+      throw std::runtime_error(file_name + " holds an unknown word");
+    }
+    book->_entries.emplace_back(history, guess);
+  }
+  if (!in || !std::is_sorted(book->_entries.begin(), book->_entries.end())) {
+    throw std::runtime_error(file_name + " is truncated or corrupt");
+  }
+  return book;
+}
+
+template class BasicOpeningBook<4>;
+template class BasicOpeningBook<5>;
+template class BasicOpeningBook<6>;
+template class BasicOpeningBook<7>;
+template class BasicOpeningBook<8>;
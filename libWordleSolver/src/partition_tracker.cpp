@@ -0,0 +1,103 @@
+#include "partition_tracker.h"
+
+#include "entropy.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+/// the change to an n_log2_n_fixed sum when a count of n goes up by one
+auto step(const std::uint32_t n) -> std::int64_t {
+  return Entropy::n_log2_n_fixed(n + 1) - Entropy::n_log2_n_fixed(n);
+}
+
+} // namespace
+
+template <int N, typename Alphabet>
+bool BasicPartitionTracker<N, Alphabet>::supports(
+    const PatternTable &patterns) {
+  return patterns.filled() &&
+         patterns.solution_count() <=
+             std::numeric_limits<std::uint16_t>::max();
+}
+
+template <int N, typename Alphabet>
+BasicPartitionTracker<N, Alphabet>::BasicPartitionTracker(
+    const PatternTable &patterns)
+    : _patterns{patterns}, _slots(patterns.guess_count(), untracked),
+      _rows(patterns.solution_count()),
+      _counts{new std::uint16_t[patterns.solution_count() *
+                                Feedback::pattern_count]},
+      _sums(patterns.solution_count()), _turns(patterns.solution_count()) {
+  for (const auto row : patterns.solution_rows()) {
+    _slots[row] = unassigned;
+  }
+}
+
+template <int N, typename Alphabet>
+void BasicPartitionTracker<N, Alphabet>::advance(
+    const std::vector<std::uint32_t> &removed) {
+  _removed.insert(_removed.end(), removed.begin(), removed.end());
+  _starts.push_back(_removed.size());
+}
+
+template <int N, typename Alphabet>
+void BasicPartitionTracker<N, Alphabet>::clear() {
+  for (std::uint32_t slot = 0; slot < _next_slot; ++slot) {
+    _slots[_rows[slot]] = unassigned;
+  }
+  _next_slot = 0;
+  _removed.clear();
+  _starts.assign(1, 0);
+}
+
+template <int N, typename Alphabet>
+double BasicPartitionTracker<N, Alphabet>::entropy(
+    const std::uint32_t row, const std::vector<std::uint32_t> &candidates) {
+  const auto turn = static_cast<std::uint32_t>(_starts.size() - 1);
+  auto slot = _slots[row];
+  const bool counted = slot != unassigned;
+  if (!counted) {
+    slot = _next_slot++;
+    _slots[row] = slot;
+    _rows[slot] = row;
+  }
+  const auto *patterns = _patterns.row(row);
+  auto *counts = &_counts[std::size_t{slot} * Feedback::pattern_count];
+  auto &sum = _sums[slot];
+
+  if (!counted || _turns[slot] != turn) {
+    const auto eliminated =
+        counted ? _starts[turn] - _starts[_turns[slot]]
+                : std::numeric_limits<std::size_t>::max();
+    if (eliminated < candidates.size() + clear_cost) {
+      const auto last = _removed.begin() + _starts[turn];
+      for (auto it = _removed.begin() + _starts[_turns[slot]]; it != last;
+           ++it) {
+        auto &count = counts[patterns[*it]];
+        --count;
+        sum -= step(count);
+      }
+      ++_updates;
+    } else {
+      std::fill_n(counts, Feedback::pattern_count, 0);
+      sum = 0;
+      for (const auto candidate : candidates) {
+        auto &count = counts[patterns[candidate]];
+        sum += step(count);
+        ++count;
+      }
+      ++_recounts;
+    }
+    _turns[slot] = turn;
+  }
+  return Entropy::entropy_of_sum(
+      sum, static_cast<std::uint32_t>(candidates.size()));
+}
+
+template class BasicPartitionTracker<4>;
+template class BasicPartitionTracker<5>;
+template class BasicPartitionTracker<6>;
+template class BasicPartitionTracker<7>;
+template class BasicPartitionTracker<8>;
@@ -0,0 +1,57 @@
+#include "pattern_table.h"
+
+#include "thread_pool.h"
+
+template <int N, typename Alphabet>
+BasicPatternTable<N, Alphabet>::BasicPatternTable(const WordList &guesses,
+                                                  const WordList &solutions,
+                                                  const bool fill)
+    : _guesses{guesses}, _solutions{solutions}, _filled{fill} {
+  _solution_rows.reserve(_solutions.size());
+  for (const auto word : _solutions) {
+    auto row = guesses.index_of(word);
+    if (row == WordList::npos) {
+      row = _guesses.size();
+      _guesses.push_back(word);
+    }
+    _solution_rows.push_back(static_cast<std::uint32_t>(row));
+  }
+  if (!fill) {
+    return;
+  }
+
+  _patterns.resize(_guesses.size() * _solutions.size());
+  const BasicSolutionBlock<N, Alphabet> block{_solutions};
+
+  constexpr std::size_t grain{64};
+  ThreadPool::shared()->parallel_for(
+      _guesses.size(), grain,
+      [this, &block](const std::size_t first, const std::size_t last) {
+        fill_rows(block, first, last);
+      });
+}
+
+template <int N, typename Alphabet>
+BasicPatternTable<N, Alphabet>::BasicPatternTable(
+    WordList guesses, WordList solutions,
+    std::vector<std::uint32_t> solution_rows, const Pattern *patterns,
+    std::shared_ptr<const void> owner)
+    : _guesses{std::move(guesses)}, _solutions{std::move(solutions)},
+      _solution_rows{std::move(solution_rows)}, _view{patterns},
+      _owner{std::move(owner)} {}
+
+template <int N, typename Alphabet>
+void BasicPatternTable<N, Alphabet>::fill_rows(
+    const BasicSolutionBlock<N, Alphabet> &block, const std::size_t first,
+    const std::size_t last) {
+  for (std::size_t guess = first; guess < last; ++guess) {
+    FeedbackBatch::patterns(_guesses[guess], block,
+                            _patterns.data() + guess * _solutions.size());
+  }
+}
+
+template class BasicPatternTable<4>;
+template class BasicPatternTable<5>;
+template class BasicPatternTable<6>;
+template class BasicPatternTable<7>;
+template class BasicPatternTable<8>;
@@ -0,0 +1,97 @@
+#include "solver_trace.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <map>
+
+namespace {
+
+using Clock = TurnTrace::Clock;
+
+/// writes the events, numbering threads in the order they appear
+class EventWriter {
+ public:
+  EventWriter(std::ostream &out, const Clock::time_point origin)
+      : _out{out}, _origin{origin} {}
+
+  /// a complete event; `args` is the inside of a JSON object, or empty
+  void complete(const std::string &name, const Clock::time_point start,
+                const Clock::duration duration, const std::thread::id thread,
+                const std::string &args = {}) {
+    _out << (_first ? "\n" : ",\n") << "    {\"name\": \"" << name
+         << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << tid(thread)
+         << ", \"ts\": " << microseconds(start - _origin)
+         << ", \"dur\": " << microseconds(duration);
+    if (!args.empty()) {
+      _out << ", \"args\": {" << args << '}';
+    }
+    _out << '}';
+    _first = false;
+  }
+
+  /// names the threads: the callers of guess, then the pool's
+  void thread_names() {
+    for (const auto &[thread, tid] : _tids) {
+      _out << ",\n    {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, "
+              "\"tid\": "
+           << tid << ", \"args\": {\"name\": \"thread " << tid << "\"}}";
+    }
+  }
+
+ private:
+  static double microseconds(const Clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+  }
+
+  auto tid(const std::thread::id thread) -> std::size_t {
+    return _tids.emplace(thread, _tids.size()).first->second;
+  }
+
+  std::ostream &_out;
+  Clock::time_point _origin;
+  std::map<std::thread::id, std::size_t> _tids;
+  bool _first{true};
+};
+
+} // namespace
+
+void write_chrome_trace(std::ostream &out,
+                        const std::vector<TurnTrace> &turns) {
+  const auto origin =
+      turns.empty() ? Clock::time_point{} : turns.front().guess_phase.start;
+  EventWriter writer{out, origin};
+  out << std::fixed << std::setprecision(3);
+  out << "{\n  \"displayTimeUnit\": \"ns\",\n  \"traceEvents\": [";
+  for (std::size_t t = 0; t < turns.size(); ++t) {
+    const auto &turn = turns[t];
+    const auto &last = turn.prune_guess_list.duration != Clock::duration{}
+                           ? turn.prune_guess_list
+                           : turn.guess_phase;
+    writer.complete(
+        "turn " + std::to_string(t + 1), turn.guess_phase.start,
+        last.start + last.duration - turn.guess_phase.start, turn.thread,
+        "\"guess\": \"" + turn.guess +
+            "\", \"candidates_before\": " +
+            std::to_string(turn.candidates_before) +
+            ", \"candidates_after\": " + std::to_string(turn.candidates_after) +
+            ", \"evaluations\": " + std::to_string(turn.evaluations) +
+            ", \"skipped\": " + std::to_string(turn.skipped) +
+            ", \"cache_hit\": " + (turn.cache_hit ? "true" : "false"));
+    for (const auto &[name, phase] :
+         {std::pair{"guess", &turn.guess_phase},
+          std::pair{"select_wordlist", &turn.select_wordlist},
+          std::pair{"eval_entropies", &turn.eval_entropies},
+          std::pair{"update_internals", &turn.update_internals},
+          std::pair{"prune_guess_list", &turn.prune_guess_list}}) {
+      if (phase->duration != Clock::duration{}) {
+        writer.complete(name, phase->start, phase->duration, turn.thread);
+      }
+    }
+    for (const auto &chunk : turn.chunks) {
+      writer.complete("chunk", chunk.start, chunk.duration, chunk.thread,
+                      "\"words\": " + std::to_string(chunk.words));
+    }
+  }
+  writer.thread_names();
+  out << "\n  ]\n}\n";
+}
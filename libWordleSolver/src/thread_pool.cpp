@@ -0,0 +1,106 @@
+#include "thread_pool.h"
+
+namespace {
+
+/// the pool and worker index of the current thread, if it is a worker
+thread_local const ThreadPool *current_pool{};
+thread_local std::size_t current_worker{};
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned thread_count) {
+  if (thread_count == 0) {
+    thread_count = std::max(1U, std::thread::hardware_concurrency());
+  }
+  _workers.reserve(thread_count - 1);
+  for (unsigned i = 0; i + 1 < thread_count; ++i) {
+    _workers.push_back(std::make_unique<Worker>());
+  }
+  _threads.reserve(_workers.size());
+  for (std::size_t i = 0; i < _workers.size(); ++i) {
+    _threads.emplace_back([this, i] { run_worker(i); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard lock(_sleep_mutex);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  for (auto &thread : _threads) {
+    thread.join();
+  }
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::shared() {
+  static const auto pool = std::make_shared<ThreadPool>();
+  return pool;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+  if (_workers.empty()) {
+    task();
+    return;
+  }
+  // keep nested work on the submitting worker, where its caches are warm
+  const auto index = current_pool == this
+                         ? current_worker
+                         : _next_worker++ % _workers.size();
+  {
+    const std::lock_guard lock(_workers[index]->mutex);
+    _workers[index]->tasks.push_back(std::move(task));
+  }
+  {
+    const std::lock_guard lock(_sleep_mutex);
+    ++_pending;
+  }
+  _wake.notify_one();
+}
+
+bool ThreadPool::take_task(const std::size_t index,
+                           std::function<void()> *task) {
+  {
+    auto &own = *_workers[index];
+    const std::lock_guard lock(own.mutex);
+    if (!own.tasks.empty()) {
+      *task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+  for (std::size_t offset = 1; offset < _workers.size(); ++offset) {
+    auto &victim = *_workers[(index + offset) % _workers.size()];
+    const std::lock_guard lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      *task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::run_worker(const std::size_t index) {
+  current_pool = this;
+  current_worker = index;
+
+  std::function<void()> task;
+  while (true) {
+    {
+      std::unique_lock lock(_sleep_mutex);
+      _wake.wait(lock, [this] { return _stopping || _pending != 0; });
+      if (_pending == 0) {
+        return;
+      }
+      --_pending;
+    }
+    // a task is queued somewhere; keep looking until it is found, since
+    // another worker may hold its deque's lock for a moment
+    while (!take_task(index, &task)) {
+      std::this_thread::yield();
+    }
+    task();
+    task = nullptr;
+  }
+}
@@ -0,0 +1,69 @@
+#include "word_list.h"
+
+#include <algorithm>
+
+template <int N, typename Alphabet>
+BasicWordList<N, Alphabet>::BasicWordList(
+    const std::vector<std::string> &words) {
+  _words.reserve(words.size());
+  for (const auto &word : words) {
+    push_back(PackedWord::parse(word));
+  }
+}
+
+template <int N, typename Alphabet>
+auto BasicWordList<N, Alphabet>::view(const PackedWord *words,
+                                      const std::size_t count,
+                                      std::shared_ptr<const void> owner)
+    -> BasicWordList {
+  BasicWordList list;
+  list._view = words;
+  list._view_size = count;
+  list._owner = std::move(owner);
+  list._sorted =
+      std::adjacent_find(list.begin(), list.end(),
+                         [](const PackedWord lhs, const PackedWord rhs) {
+                           return !(lhs < rhs);
+                         }) == list.end();
+  return list;
+}
+
+template <int N, typename Alphabet>
+void BasicWordList<N, Alphabet>::push_back(const PackedWord word) {
+  if (_view != nullptr) {
+    _words.assign(begin(), end());
+    _view = nullptr;
+    _view_size = 0;
+    _owner.reset();
+  }
+  _sorted = _sorted && (_words.empty() || _words.back() < word);
+  _words.push_back(word);
+}
+
+template <int N, typename Alphabet>
+std::size_t BasicWordList<N, Alphabet>::index_of(const PackedWord word) const {
+  if (_sorted) {
+    const auto found = std::lower_bound(begin(), end(), word);
+    return (found != end() && *found == word)
+               ? static_cast<std::size_t>(found - begin())
+               : npos;
+  }
+  const auto found = std::find(begin(), end(), word);
+  return found != end() ? static_cast<std::size_t>(found - begin()) : npos;
+}
+
+template <int N, typename Alphabet>
+std::vector<std::string> BasicWordList<N, Alphabet>::to_strings() const {
+  std::vector<std::string> words;
+  words.reserve(size());
+  for (const auto word : *this) {
+    words.push_back(word.to_string());
+  }
+  return words;
+}
+
+template class BasicWordList<4>;
+template class BasicWordList<5>;
+template class BasicWordList<6>;
+template class BasicWordList<7>;
+template class BasicWordList<8>;
@@ -1,23 +1,236 @@
 #include "wordle_solver.h"
 
-#include "entropy.h"
+#include "dictionary.h"
+#include "entropy_bound.h"
+#include "expected_guesses.h"
 #include "feedback.h"
+#include "thread_pool.h"
 
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
-#include <future>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
 #include <thread>
-#include <unordered_map>
 
-WordleSolver::WordleSolver()
-    : _all_words{load_wordlist("word_lists/all_words.txt")},
-      _all_solutions{load_wordlist("word_lists/all_solutions.txt")},
-      _letters_go_here{std::vector(word_len, '0')},
-      _letters_dont_go_here{std::vector(word_len, '0')} {}
+namespace {
 
+using Best = std::pair<double, std::size_t>; // score, wordlist position
+
+/// small chunks keep the threads busy until the end of the list
+constexpr std::size_t grain{32};
+
+/// the higher score, or on a tie the earlier position, so results don't
+/// depend on how the list was split between threads
+Best better(const Best &lhs, const Best &rhs) {
+  if (lhs.first != rhs.first) {
+    return lhs.first > rhs.first ? lhs : rhs;
+  }
+  return lhs.second < rhs.second ? lhs : rhs;
+}
+
+/**
+ * `line` of a word list without the '\r' of Windows line endings
+ * @throws std::invalid_argument, naming `origin` and the line `number`,
+ *         unless what is left is a word `PackedWord` can hold
+ */
+template <typename PackedWord>
+std::string checked_word(std::string line, const std::string_view origin,
+                         const std::size_t number) {
+  if (!line.empty() && line.back() == '\r') {
+    line.pop_back();
+  }
+  try {
+    static_cast<void>(PackedWord::parse(line));
+  } catch (const std::invalid_argument &error) {
+    throw std::invalid_argument(std::string{origin} + ':' +
+                                std::to_string(number) + ": " + error.what());
+  }
+  return line;
+}
+
+/// times a phase of the turn being traced; does nothing given nullptr
+class PhaseTimer {
+ public:
+  explicit PhaseTimer(TurnTrace::Phase *phase) : _phase{phase} {
+    if (_phase != nullptr) {
+      _phase->start = TurnTrace::Clock::now();
+    }
+  }
+  ~PhaseTimer() {
+    if (_phase != nullptr) {
+      _phase->duration = TurnTrace::Clock::now() - _phase->start;
+    }
+  }
+
+  PhaseTimer(const PhaseTimer &) = delete;
+  PhaseTimer &operator=(const PhaseTimer &) = delete;
+  PhaseTimer(PhaseTimer &&) = delete;
+  PhaseTimer &operator=(PhaseTimer &&) = delete;
+
+ private:
+  TurnTrace::Phase *_phase;
+};
+
+/**
+ * Times the chunks of a parallel loop over `count` words into the turn being
+ * traced, each in the slot of its index, so threads never share one
+ */
+class ChunkRecorder {
+ public:
+  ChunkRecorder(TurnTrace *turn, const std::size_t count)
+      : _turn{turn}, _base{turn != nullptr ? turn->chunks.size() : 0} {
+    if (_turn != nullptr) {
+      _turn->chunks.resize(_base + (count + grain - 1) / grain);
+    }
+  }
+
+  /// run `body` for the chunk at `first`; it returns the words it scored
+  template <typename Body>
+  void operator()(const std::size_t first, Body body) const {
+    if (_turn == nullptr) {
+      static_cast<void>(body());
+      return;
+    }
+    auto &chunk = _turn->chunks[_base + first / grain];
+    chunk.thread = std::this_thread::get_id();
+    chunk.start = TurnTrace::Clock::now();
+    chunk.words = static_cast<std::uint32_t>(body());
+    chunk.duration = TurnTrace::Clock::now() - chunk.start;
+  }
+
+ private:
+  TurnTrace *_turn;
+  std::size_t _base;
+};
+
+/// fold `value` into `hash`, with a multiply-xorshift mix
+std::uint64_t mix(const std::uint64_t hash, const std::uint64_t value) {
+  auto mixed = (hash ^ value) * 0x9e3779b97f4a7c15;
+  return mixed ^ (mixed >> 29U);
+}
+
+} // namespace
+
+template <int N, typename Alphabet>
+BasicWordleSolver<N, Alphabet>::BasicWordleSolver()
+    : BasicWordleSolver{WordLists::files} {}
+
+template <int N, typename Alphabet>
+BasicWordleSolver<N, Alphabet>::BasicWordleSolver(const WordLists word_lists)
+    : BasicWordleSolver{word_lists == WordLists::embedded
+                            ? Dictionary::embedded()
+                            : Dictionary::shared_default()} {}
+
+template <int N, typename Alphabet>
+BasicWordleSolver<N, Alphabet>::BasicWordleSolver(
+    std::shared_ptr<const Dictionary> dictionary)
+    : _dictionary{std::move(dictionary)}, _pool{ThreadPool::shared()} {
+  if (!_dictionary->has_table()) {
+    _rows = std::make_shared<FeedbackRows>();
+  }
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::reset() {
+  _last_guess = opening_guess();
+  _feedback.clear();
+  _iteration = 0;
+  _history.clear();
+  _tree_node = DecisionTree::root();
+  _constraints = Constraints{};
+  _guess_list.clear();
+  _trace.clear();
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_thread_count(
+    const unsigned thread_count) {
+  _pool = std::make_shared<ThreadPool>(std::max(1U, thread_count));
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_thread_pool(
+    std::shared_ptr<ThreadPool> pool) {
+  _pool = std::move(pool);
+}
+
+template <int N, typename Alphabet>
+unsigned BasicWordleSolver<N, Alphabet>::thread_count() const {
+  return _pool->thread_count();
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_search(const Search search) {
+  _search = search;
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_hard_mode(const bool hard_mode) {
+  _hard_mode = hard_mode;
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_lookahead(
+    const std::size_t candidates, const std::chrono::milliseconds budget) {
+  _lookahead_candidates = candidates;
+  _lookahead_budget = budget;
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_opening_book(
+    std::shared_ptr<const OpeningBook> book) {
+  _opening_book = std::move(book);
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_decision_tree(
+    std::shared_ptr<const DecisionTree> tree) {
+  _tree = std::move(tree);
+  _tree_node = DecisionTree::root();
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_guess_cache(
+    std::shared_ptr<GuessCache> cache) {
+  _guess_cache = std::move(cache);
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_feedback_rows(
+    std::shared_ptr<FeedbackRows> rows) {
+  if (_dictionary->has_table()) {
+    return;
+  }
+  _rows = rows ? std::move(rows) : std::make_shared<FeedbackRows>();
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_partition_tracking(
+    const bool tracking) {
+  _tracking.on = tracking;
+  if (!tracking) {
+    _tracking.tracker.reset();
+  }
+}
+
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::set_tracing(const bool tracing) {
+  _tracing = tracing;
+}
+
+template <int N, typename Alphabet>
+std::size_t BasicWordleSolver<N, Alphabet>::remaining() const {
+  return _history.empty() ? _dictionary->all_solutions().size()
+                          : _guess_list.size();
+}
+
+template <int N, typename Alphabet>
 std::vector<std::string>
-WordleSolver::load_wordlist(const std::string_view file_name) {
+BasicWordleSolver<N, Alphabet>::load_wordlist(
+    const std::string_view file_name) {
   std::vector<std::string> wordlist;
   if (!std::filesystem::exists(file_name)) {
     std::cerr << "Cannot find file '" << file_name << "' in search path:\n"
@@ -26,8 +239,11 @@ WordleSolver::load_wordlist(const std::string_view file_name) {
   }
   if (std::ifstream in_file((file_name.data())); in_file.is_open()) {
     std::string line;
-    while (std::getline(in_file, line)) {
-      wordlist.push_back(line);
+    for (std::size_t number = 1; std::getline(in_file, line); ++number) {
+      if (!line.empty()) {
+        wordlist.push_back(
+            checked_word<PackedWord>(std::move(line), file_name, number));
+      }
     }
   } else {
     std::cerr << "Failed to open file " << file_name << '\n';
@@ -36,286 +252,476 @@ WordleSolver::load_wordlist(const std::string_view file_name) {
   return wordlist;
 }
 
+template <int N, typename Alphabet>
 std::vector<std::string>
-WordleSolver::load_wordlist(const char *characters, const unsigned int length) {
+BasicWordleSolver<N, Alphabet>::load_wordlist(const char *characters,
+                                              const unsigned int length) {
   std::vector<std::string> wordlist;
   wordlist.reserve(length / (word_len + 1));
   std::string word;
+  std::size_t number{1};
 
   for (unsigned int i = 0; i < length; ++i) {
     if (*std::next(characters, i) != '\n') {
       word += *std::next(characters, i);
     } else if (*std::next(characters, i) == '\n') {
-      wordlist.push_back(word);
+      if (!word.empty()) {
+        wordlist.push_back(
+            checked_word<PackedWord>(std::move(word), "word list", number));
+      }
       word.clear();
+      ++number;
     }
   }
   return wordlist;
 }
 
-void WordleSolver::accept_feedback(const std::string &feedback) {
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::accept_feedback(
+    const std::string &feedback) {
   _feedback = feedback;
+  _history.push_back(Feedback::to_pattern(_feedback));
+  // guess() left the tree if hard mode ruled out its guess
+  if (_tree && _tree_node != DecisionTree::npos) {
+    _tree_node = _tree->next(_tree_node, _history.back());
+  }
   update_guess_list();
 }
 
-void WordleSolver::update_guess_list() {
-  // the pruning methods may not remove the last guess if there are duplicate
-  // letters in the guess, e.g. "nanny"
-  _guess_list.erase(
-      std::remove(_guess_list.begin(), _guess_list.end(), _last_guess),
-      _guess_list.end());
-
-  update_internals();
-  prune_guess_list();
-}
-
-void WordleSolver::update_internals() {
-  _pos_positions.clear();
-  _neg_positions.clear();
-
-  interpret_feedback();
-
-  sort_remove_duplicates(&_exclude_letters);
-  sort_remove_duplicates(&_include_letters);
-}
-
-void WordleSolver::interpret_feedback() {
-  for (int i = 0; i < word_len; ++i) {
-    switch (_feedback[i]) {
-    case 'x': _exclude_letters.push_back(_last_guess[i]); break;
-    case 'y':
-      _include_letters.push_back(_last_guess[i]);
-      _neg_positions.push_back(i);
-      _letters_dont_go_here[i] = _last_guess[i];
-      break;
-    case 'g':
-      _include_letters.push_back(_last_guess[i]);
-      _pos_positions.push_back(i);
-      _letters_go_here[i] = _last_guess[i];
-      break;
-    default:;
-    }
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::update_guess_list() {
+  auto *turn = traced_turn();
+  {
+    const PhaseTimer timer{turn != nullptr ? &turn->update_internals
+                                           : nullptr};
+    update_internals();
+  }
+  {
+    const PhaseTimer timer{turn != nullptr ? &turn->prune_guess_list
+                                           : nullptr};
+    prune_guess_list();
+  }
+  if (turn != nullptr) {
+    turn->candidates_after = _guess_list.size();
   }
 }
 
-void WordleSolver::sort_remove_duplicates(std::vector<char> *vec) {
-  std::sort(vec->begin(), vec->end());
-  vec->erase(std::unique(vec->begin(), vec->end()), vec->end());
-}
-
-void WordleSolver::prune_guess_list() {
-  process_exclude_letters();
-  process_include_letters();
-  process_yellow_letters();
-  process_green_letters();
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::update_internals() {
+  _constraints.add(_last_guess, _history.back());
 }
 
-void WordleSolver::process_exclude_letters() {
-  prefer_include_over_exclude();
-
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::prune_guess_list() {
   if (_iteration == 1) {
-    process_first_exclude_letters();
-  } else {
-    for (auto word = _guess_list.begin(); word != _guess_list.end();) {
-      bool found{false};
-      for (const auto letter : _exclude_letters) {
-        if (word->find(letter) != std::string::npos) {
-          found = true;
-          break;
-        }
-      }
-      if (found) {
-        word = _guess_list.erase(word);
-      } else {
-        ++word;
+    const auto &all_solutions = _dictionary->all_solutions();
+    for (std::uint32_t index = 0; index < all_solutions.size(); ++index) {
+      if (_constraints.allows(all_solutions[index])) {
+        _guess_list.push_back(index);
       }
     }
+    // the tracker's counts may be of the last game
+    if (_tracking.tracker) {
+      _tracking.tracker->clear();
+    }
+  } else if (_tracking.tracker) {
+    std::vector<std::uint32_t> removed;
+    _constraints.filter(_dictionary->all_solutions(), &_guess_list, &removed);
+    _tracking.tracker->advance(removed);
+  } else {
+    _constraints.filter(_dictionary->all_solutions(), &_guess_list);
   }
 }
 
-void WordleSolver::prefer_include_over_exclude() {
-  _exclude_letters.erase(
-      std::remove_if(_exclude_letters.begin(), _exclude_letters.end(),
-                     [&](const auto ch_ex) {
-                       return std::find(_include_letters.begin(),
-                                        _include_letters.end(),
-                                        ch_ex) != _include_letters.end();
-                     }),
-      _exclude_letters.end());
+template <int N, typename Alphabet>
+auto BasicWordleSolver<N, Alphabet>::guess(
+    const Clock::time_point deadline, const CancellationToken *cancel)
+    -> AnytimeGuess {
+  _deadline = deadline;
+  _cancel = cancel;
+  AnytimeGuess result;
+  result.word = guess();
+  _deadline.reset();
+  _cancel = nullptr;
+  result.words = _search_words;
+  result.covered = _search_covered;
+  result.complete = _search_covered == _search_words;
+  return result;
 }
 
-void WordleSolver::process_first_exclude_letters() {
-  for (const auto &word : _all_solutions) {
-    bool found{false};
-    for (const auto letter : _exclude_letters) {
-      if (word.find(letter) != std::string::npos) {
-        found = true;
-        break;
-      }
-    }
-    if (!found) {
-      _guess_list.push_back(word);
-    }
-  }
+template <int N, typename Alphabet>
+bool BasicWordleSolver<N, Alphabet>::stop_requested() const {
+  return (_cancel != nullptr && _cancel->cancelled()) ||
+         (_deadline && Clock::now() >= *_deadline);
 }
 
-void WordleSolver::process_include_letters() {
-  for (auto word = _guess_list.begin(); word != _guess_list.end();) {
-    bool found{true};
-    for (const auto letter : _include_letters) {
-      if (word->find(letter) == std::string::npos) {
-        found = false;
-        break;
-      }
+template <int N, typename Alphabet>
+std::string BasicWordleSolver<N, Alphabet>::guess() {
+  _search_words = 0;
+  _search_covered = 0;
+  if (_tracing) {
+    _trace.emplace_back();
+    _trace.back().thread = std::this_thread::get_id();
+    _trace.back().candidates_before = remaining();
+  }
+  auto *turn = traced_turn();
+  const PhaseTimer timer{turn != nullptr ? &turn->guess_phase : nullptr};
+  if (_tree && _tree_node != DecisionTree::npos && _hard_mode &&
+      !_constraints.allows_guess(_tree->guess(_tree_node))) {
+    _tree_node = DecisionTree::npos; // the rest of the game is searched
+  }
+  if (_tree && _tree_node != DecisionTree::npos) {
+    // every node the feedback reaches has candidates left
+    _last_guess = _tree->guess(_tree_node);
+  } else if (_iteration != 0) {
+    if (_guess_list.empty()) {
+      std::cerr << "No solution: \n"
+                << "\t- Solution is missing from dictionary, or\n"
+                << "\t- Incorrect user input\n";
+      std::exit(EXIT_FAILURE);
+    }
+    auto book_guess =
+        _opening_book ? _opening_book->find(_history) : std::nullopt;
+    if (book_guess && _hard_mode && !_constraints.allows_guess(*book_guess)) {
+      book_guess.reset();
     }
-    if (!found) {
-      word = _guess_list.erase(word);
+    if (book_guess) {
+      _last_guess = *book_guess;
+    } else if (_guess_list.size() == 1) {
+      _last_guess = _dictionary->all_solutions()[_guess_list[0]];
     } else {
-      ++word;
+      _last_guess = eval_entropies();
     }
+  } else if (!fixed_opening) {
+    const auto book_guess =
+        _opening_book ? _opening_book->find(_history) : std::nullopt;
+    _last_guess = book_guess ? *book_guess : search_opening();
   }
+  ++_iteration;
+  if (turn != nullptr) {
+    turn->guess = _last_guess.to_string();
+  }
+  return _last_guess.to_string();
 }
 
-void WordleSolver::process_yellow_letters() {
-  for (auto word = _guess_list.begin(); word != _guess_list.end();) {
-    bool found{false};
-    for (const auto index : _neg_positions) {
-      if (word->at(index) == _letters_dont_go_here[index]) {
-        found = true;
-        break;
-      }
-    }
-    if (found) {
-      word = _guess_list.erase(word);
-    } else {
-      ++word;
+template <int N, typename Alphabet>
+std::vector<std::uint32_t>
+BasicWordleSolver<N, Alphabet>::select_wordlist() const {
+  if (_iteration == 0 && _guess_list.size() > small_list_size) {
+    std::vector<std::uint32_t> rows(_dictionary->all_words().size());
+    std::iota(rows.begin(), rows.end(), 0);
+    return rows;
+  }
+  if (_guess_list.size() <= small_list_size) {
+    std::vector<std::uint32_t> rows;
+    rows.reserve(_guess_list.size());
+    for (const auto index : _guess_list) {
+      rows.push_back(_dictionary->patterns().solution_rows()[index]);
     }
+    return rows;
   }
-}
-
-void WordleSolver::process_green_letters() {
-  for (auto word = _guess_list.begin(); word != _guess_list.end();) {
-    bool found{true};
-    for (const auto index : _pos_positions) {
-      if (word->at(index) != _letters_go_here[index]) {
-        found = false;
-        break;
+  if (_hard_mode) {
+    // the candidates always pass, so the list is never empty
+    const auto &guesses = _dictionary->patterns().guesses();
+    std::vector<std::uint32_t> rows;
+    for (const auto row : _dictionary->patterns().solution_rows()) {
+      if (_constraints.allows_guess(guesses[row])) {
+        rows.push_back(row);
       }
     }
-    if (!found) {
-      word = _guess_list.erase(word);
-    } else {
-      ++word;
-    }
+    return rows;
   }
+  return _dictionary->patterns().solution_rows();
 }
 
-std::string WordleSolver::guess() {
-  std::string guess;
-  if (_iteration == 0) {
-    guess = _last_guess;
-  } else if (_guess_list.size() == 1) {
-    _last_guess = _guess_list[0];
-    guess = _last_guess;
-  } else {
-    if (_guess_list.empty()) {
-      std::cerr << "No solution: \n"
-                << "\t- Solution is missing from dictionary, or\n"
-                << "\t- Incorrect user input\n";
-      std::exit(EXIT_FAILURE);
+template <int N, typename Alphabet>
+auto BasicWordleSolver<N, Alphabet>::eval_entropies() -> PackedWord {
+  auto *turn = traced_turn();
+  const auto wordlist = [this, turn] {
+    const PhaseTimer timer{turn != nullptr ? &turn->select_wordlist
+                                           : nullptr};
+    return select_wordlist();
+  }();
+  const PhaseTimer timer{turn != nullptr ? &turn->eval_entropies : nullptr};
+  const auto &guesses = _dictionary->patterns().guesses();
+
+  // a few candidates are quicker to score than to hash
+  if (!_guess_cache || _guess_list.size() <= small_list_size) {
+    return guesses[best_row(wordlist)];
+  }
+  const auto key = GuessCache::key(cache_settings(wordlist), _guess_list);
+  if (const auto row = _guess_cache->find(key)) {
+    _search_words = wordlist.size();
+    _search_covered = wordlist.size();
+    if (turn != nullptr) {
+      turn->cache_hit = true;
     }
-    _last_guess = eval_entropies();
-    guess = _last_guess;
+    return guesses[*row];
   }
-  ++_iteration;
-  return guess;
+  const auto row = best_row(wordlist);
+  if (_search_covered == _search_words) {
+    _guess_cache->insert(key, row);
+  }
+  return guesses[row];
 }
 
-const std::vector<std::string> *WordleSolver::select_wordlist() const {
-  static constexpr int cutoff{5};
-
-  if (_iteration == 0 && _guess_list.size() > cutoff) {
-    return &_all_words;
+template <int N, typename Alphabet>
+std::uint64_t BasicWordleSolver<N, Alphabet>::cache_settings(
+    const std::vector<std::uint32_t> &wordlist) const {
+  auto settings = mix(_dictionary->fingerprint(), N);
+  // the opening scores every word rather than the solutions
+  settings = mix(settings, _iteration == 0 ? 1 : 0);
+  // guesses made without the lookahead mustn't answer for those made with it
+  if (lookahead()) {
+    settings = mix(settings, _lookahead_candidates);
+    settings = mix(settings,
+                   static_cast<std::uint64_t>(_lookahead_budget.count()));
   }
-  if (_guess_list.size() <= cutoff) {
-    return &_guess_list;
+  // in hard mode the words allowed depend on more than the candidates
+  if (_hard_mode) {
+    settings = mix(settings, wordlist.size());
+    for (const auto row : wordlist) {
+      settings = mix(settings, row);
+    }
   }
-  return &_all_solutions;
+  return settings;
 }
 
-std::string WordleSolver::eval_entropies() const {
-  std::string best_word{};
-  const auto *const wordlist = select_wordlist();
+template <int N, typename Alphabet>
+bool BasicWordleSolver<N, Alphabet>::lookahead() const {
+  // a deadline needs the bounded search, which is the one that can stop, and
+  // rows computed on demand can't serve ExpectedGuesses
+  return _lookahead_candidates > 1 && !_deadline && !_rows;
+}
 
-  if (constexpr auto cutoff{999}; wordlist->size() > cutoff) {
-    const auto thread_count = std::max(1U, std::thread::hardware_concurrency());
-    const auto chunk_size =
-        static_cast<std::ptrdiff_t>(wordlist->size() / thread_count);
+template <int N, typename Alphabet>
+std::uint32_t BasicWordleSolver<N, Alphabet>::best_row(
+    const std::vector<std::uint32_t> &wordlist) {
+  _search_words = wordlist.size();
+  _search_covered = wordlist.size();
+  const bool anytime = _deadline.has_value();
+  // the opening's candidates aren't pruned from the turn before
+  if (_tracking.on && !_tracking.tracker && _iteration != 0 &&
+      PartitionTracker::supports(_dictionary->patterns())) {
+    _tracking.tracker =
+        std::make_unique<PartitionTracker>(_dictionary->patterns());
+  }
+  // rows computed on demand cover only the candidates of this turn
+  if (_rows) {
+    _candidates = typename FeedbackRows::Candidates{
+        _dictionary->fingerprint(), _dictionary->all_solutions(),
+        _guess_list};
+  }
+  if (lookahead() && _guess_list.size() > small_list_size) {
+    return wordlist[get_best_word_lookahead(wordlist)];
+  }
 
-    std::vector<std::vector<std::string>::const_iterator> ranges;
-    ranges.reserve(thread_count + 1);
+  if ((_search == Search::branch_and_bound || anytime) &&
+      _guess_list.size() > small_list_size) {
+    return wordlist[get_best_word_bounded(wordlist)];
+  }
 
-    for (unsigned i = 0; i < thread_count; ++i) {
-      ranges.emplace_back(std::next(wordlist->cbegin(), i * chunk_size));
-    }
-    ranges.emplace_back(wordlist->cend());
+  auto *turn = traced_turn();
+  const ChunkRecorder chunks{turn, wordlist.size()};
+  const auto [score, position] = _pool->parallel_reduce(
+      wordlist.size(), grain, Best{std::numeric_limits<double>::lowest(), 0},
+      [this, &wordlist, &chunks](const std::size_t first,
+                                 const std::size_t last, Best &best) {
+        chunks(first, [&] {
+          best = better(best, get_best_word(wordlist, first, last));
+          return last - first;
+        });
+      },
+      better);
+  if (turn != nullptr) {
+    turn->evaluations += wordlist.size();
+  }
 
-    std::vector<std::future<std::pair<double, std::string>>> futures;
-    futures.reserve(thread_count);
+  return wordlist[position];
+}
 
-    for (unsigned i = 0; i < thread_count; ++i) {
-      futures.emplace_back(std::async(std::launch::async, [this, &ranges, i] {
-        return get_best_word(ranges[i], ranges[i + 1]);
-      }));
-    }
+template <int N, typename Alphabet>
+std::size_t BasicWordleSolver<N, Alphabet>::get_best_word_bounded(
+    const std::vector<std::uint32_t> &wordlist) {
+  // Rounding may put a bound a hair under an entropy it equals; the margin
+  // keeps such a word, which could still win a tie on position.
+  constexpr double margin{1e-9};
+
+  const BasicEntropyBound<N, Alphabet> bound{_dictionary->all_solutions(),
+                                             _guess_list};
+  const auto &guesses = _dictionary->patterns().guesses();
+  std::vector<std::pair<double, std::uint32_t>> order; // bound, position
+  order.reserve(wordlist.size());
+  for (std::uint32_t position = 0; position < wordlist.size(); ++position) {
+    order.emplace_back(bound(guesses[wordlist[position]]), position);
+  }
+  std::sort(order.begin(), order.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.first != rhs.first ? lhs.first > rhs.first
+                                  : lhs.second < rhs.second;
+  });
+
+  // the best score found so far by any thread
+  constexpr double none{std::numeric_limits<double>::lowest()};
+  std::atomic<double> running{none};
+  std::atomic<std::uint64_t> skipped{};
+  std::atomic<std::uint64_t> scored{};
+  auto *turn = traced_turn();
+  const ChunkRecorder chunks{turn, order.size()};
+  const auto [score, position] = _pool->parallel_reduce(
+      order.size(), grain, Best{std::numeric_limits<double>::lowest(), 0},
+      [this, &wordlist, &order, &running, &skipped, &scored, &chunks](
+          const std::size_t first, const std::size_t last, Best &best) {
+        chunks(first, [&] {
+          auto k = first;
+          for (; k < last; ++k) {
+            // the order is by bound, so nothing after this can win either
+            if (order[k].first + margin < running.load()) {
+              skipped += last - k;
+              break;
+            }
+            // past a deadline, keep what's found, once something is
+            if (running.load() != none && stop_requested()) {
+              break;
+            }
+            const auto position = order[k].second;
+            const double score = get_score(wordlist[position]);
+            best = better(best, Best{score, position});
+            auto seen = running.load();
+            while (score > seen &&
+                   !running.compare_exchange_weak(seen, score)) {
+            }
+          }
+          scored += k - first;
+          return k - first;
+        });
+      },
+      better);
+  _skipped_evaluations += skipped;
+  _search_covered = scored + skipped;
+  if (turn != nullptr) {
+    turn->evaluations += scored;
+    turn->skipped += skipped;
+  }
 
-    std::vector<std::pair<double, std::string>> best_words;
-    best_words.reserve(futures.size());
+  return position;
+}
 
-    for (auto &future : futures) {
-      best_words.emplace_back(future.get());
+template <int N, typename Alphabet>
+std::size_t BasicWordleSolver<N, Alphabet>::get_best_word_lookahead(
+    const std::vector<std::uint32_t> &wordlist) {
+  using ExpectedGuesses = BasicExpectedGuesses<N, Alphabet>;
+  const auto deadline = ExpectedGuesses::Clock::now() + _lookahead_budget;
+
+  std::vector<double> scores(wordlist.size());
+  auto *turn = traced_turn();
+  const ChunkRecorder chunks{turn, wordlist.size()};
+  _pool->parallel_for(
+      wordlist.size(), grain,
+      [this, &wordlist, &scores, &chunks](const std::size_t first,
+                                          const std::size_t last) {
+        chunks(first, [&] {
+          for (auto position = first; position < last; ++position) {
+            scores[position] = get_score(wordlist[position]);
+          }
+          return last - first;
+        });
+      });
+  if (turn != nullptr) {
+    turn->evaluations += wordlist.size();
+  }
+  std::vector<std::size_t> order(wordlist.size());
+  std::iota(order.begin(), order.end(), 0);
+  const auto count = std::min(_lookahead_candidates, order.size());
+  std::partial_sort(order.begin(), order.begin() + count, order.end(),
+                    [&scores](const std::size_t lhs, const std::size_t rhs) {
+                      return scores[lhs] != scores[rhs]
+                                 ? scores[lhs] > scores[rhs]
+                                 : lhs < rhs;
+                    });
+
+  // fewest expected guesses, or on a tie the higher entropy; words not
+  // scored before the deadline drop out, leaving the best by entropy
+  using Choice = std::pair<double, std::size_t>; // guesses, rank in order
+  const auto fewer = [](const Choice &lhs, const Choice &rhs) {
+    if (lhs.first != rhs.first) {
+      return lhs.first < rhs.first ? lhs : rhs;
     }
+    return lhs.second < rhs.second ? lhs : rhs;
+  };
+  const ExpectedGuesses expected{_dictionary->patterns(), wordlist, deadline};
+  std::atomic<std::size_t> scored{};
+  const auto [guesses, rank] = _pool->parallel_reduce(
+      count, 1, Choice{std::numeric_limits<double>::max(), 0},
+      [this, &wordlist, &order, &expected, &fewer,
+       &scored](const std::size_t first, const std::size_t last, Choice &best) {
+        for (auto rank = first; rank < last; ++rank) {
+          if (const auto score = expected(wordlist[order[rank]], _guess_list)) {
+            best = fewer(best, Choice{*score, rank});
+            ++scored;
+          }
+        }
+      },
+      fewer);
+  // words the budget passed over leave the search incomplete, so it isn't
+  // cached: a slow turn mustn't fix its fallback for every solver
+  _search_covered = wordlist.size() - (count - scored);
 
-    auto [max_score, max_word] =
-        std::make_pair(std::numeric_limits<double>::min(), std::string{});
+  return order[rank];
+}
 
-    for (const auto &[score, word] : best_words) {
-      if (score > max_score) {
-        max_score = score;
-        best_word = word;
-      }
-    }
-  } else {
-    best_word = get_best_word(wordlist->cbegin(), wordlist->cend()).second;
+template <int N, typename Alphabet>
+double
+BasicWordleSolver<N, Alphabet>::get_score(const std::uint32_t row) const {
+  if (_tracking.tracker && _iteration != 0 &&
+      _tracking.tracker->tracks(row)) {
+    return _tracking.tracker->entropy(row, _guess_list);
   }
-  return best_word;
+  PatternHistogram histogram;
+  count_patterns(row, &histogram);
+  return histogram.entropy();
 }
 
-std::pair<double, std::string> WordleSolver::get_best_word(
-    const std::vector<std::string>::const_iterator first,
-    const std::vector<std::string>::const_iterator last) const {
-
-  std::vector<std::pair<double, std::string>> entropies;
-  entropies.reserve(std::distance(first, last));
-
-  for (auto it = first; it != last; ++it) {
-    std::unordered_map<Feedback::Code, double> feedback_to_freq;
-
-    for (const auto &word : _guess_list) {
-      ++feedback_to_freq[Feedback::feedback(*it, word)];
-    }
-    double score = Entropy::entropy(feedback_to_freq);
-    entropies.emplace_back(score, *it);
+template <int N, typename Alphabet>
+void BasicWordleSolver<N, Alphabet>::count_patterns(
+    const std::uint32_t row, PatternHistogram *histogram) const {
+  if (_rows) {
+    _rows->count(_candidates, row, _dictionary->patterns().guesses()[row],
+                 histogram);
+    return;
   }
+  histogram->count(_dictionary->patterns().row(row), _guess_list.begin(),
+                   _guess_list.end());
+}
 
-  auto [max_score, max_word] =
-      std::make_pair(std::numeric_limits<double>::min(), std::string{});
+template <int N, typename Alphabet>
+std::pair<double, std::size_t> BasicWordleSolver<N, Alphabet>::get_best_word(
+    const std::vector<std::uint32_t> &wordlist, const std::size_t first,
+    const std::size_t last) const {
+  auto [max_score, max_position] =
+      std::make_pair(std::numeric_limits<double>::lowest(), first);
 
-  for (const auto &[score, word] : entropies) {
+  for (auto position = first; position < last; ++position) {
+    const double score = get_score(wordlist[position]);
     if (score > max_score) {
       max_score = score;
-      max_word = word;
+      max_position = position;
     }
   }
-  return {max_score, max_word};
+  return {max_score, max_position};
+}
+
+template <int N, typename Alphabet>
+auto BasicWordleSolver<N, Alphabet>::search_opening() -> PackedWord {
+  // the first turn scores every word against every solution
+  _guess_list.resize(_dictionary->all_solutions().size());
+  std::iota(_guess_list.begin(), _guess_list.end(), 0);
+  const auto opening = eval_entropies();
+  _guess_list.clear();
+  return opening;
 }
+
+template class BasicWordleSolver<4>;
+template class BasicWordleSolver<5>;
+template class BasicWordleSolver<6>;
+template class BasicWordleSolver<7>;
+template class BasicWordleSolver<8>;
@@ -0,0 +1,84 @@
+#include "constraints.h"
+#include "feedback.h"
+#include "wordle_solver.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+
+int main() {
+  const WordList solutions{
+      WordleSolver::load_wordlist("word_lists/all_solutions.txt")};
+  const WordList guesses{std::vector<std::string>{
+      "tarse", "nanny", "eerie", "geese", "abbey", "lolly", "mamma"}};
+
+  std::size_t failures{};
+  std::size_t checks{};
+
+  // A word must pass the constraints exactly when it gives the same feedback
+  // as the solution for every guess played so far.
+  for (std::size_t s = 0; s < solutions.size(); s += 7) {
+    const auto solution = solutions[s];
+    Constraints constraints;
+    for (std::size_t played = 0; played < guesses.size(); ++played) {
+      constraints.add(guesses[played],
+                      Feedback::pattern(guesses[played], solution));
+      for (const auto word : solutions) {
+        bool consistent{true};
+        for (std::size_t g = 0; g <= played; ++g) {
+          consistent =
+              consistent && Feedback::pattern(guesses[g], word) ==
+                                Feedback::pattern(guesses[g], solution);
+        }
+        ++checks;
+        if (constraints.allows(word) != consistent && ++failures <= 10) {
+          std::cout << "solution " << solution.to_string() << ", word "
+                    << word.to_string() << ", after " << played + 1
+                    << " guesses: expected " << consistent << '\n';
+        }
+
+        // hard mode: greens stay, and revealed letters are used as often
+        bool playable{true};
+        for (std::size_t g = 0; g <= played; ++g) {
+          const auto hints = Feedback::feedback_string(
+              guesses[g].to_string(), solution.to_string());
+          std::array<int, PackedWord::alphabet_size> revealed{};
+          for (int i = 0; i < PackedWord::length; ++i) {
+            if (hints[i] == 'g' && word.letter(i) != guesses[g].letter(i)) {
+              playable = false;
+            }
+            revealed[guesses[g].letter(i)] +=
+                static_cast<int>(hints[i] != 'x');
+          }
+          for (int i = 0; i < PackedWord::length; ++i) {
+            revealed[word.letter(i)] -= 1;
+          }
+          playable = playable && std::all_of(revealed.begin(), revealed.end(),
+                                             [](const int missing) {
+                                               return missing <= 0;
+                                             });
+        }
+        ++checks;
+        if (constraints.allows_guess(word) != playable && ++failures <= 10) {
+          std::cout << "solution " << solution.to_string() << ", guess "
+                    << word.to_string() << ", after " << played + 1
+                    << " guesses: expected playable " << playable << '\n';
+        }
+      }
+    }
+
+    std::vector<std::uint32_t> indices(solutions.size());
+    for (std::uint32_t i = 0; i < indices.size(); ++i) {
+      indices[i] = i;
+    }
+    constraints.filter(solutions, &indices);
+    if (std::find(indices.begin(), indices.end(), s) == indices.end() &&
+        ++failures <= 10) {
+      std::cout << "filter removed the solution " << solution.to_string()
+                << '\n';
+    }
+  }
+
+  std::cout << checks << " words checked, " << failures << " failures\n";
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,198 @@
+#include "feedback.h"
+#include "server.h"
+#include "thread_pool.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/// a client connection, one request and reply at a time unless pipelined
+class Client {
+ public:
+  explicit Client(const std::string &path)
+      : _fd{::socket(AF_UNIX, SOCK_STREAM, 0)} {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    if (_fd < 0 || ::connect(_fd, reinterpret_cast<const sockaddr *>(&address),
+                             sizeof(address)) != 0) {
+      throw std::runtime_error("Cannot connect to " + path);
+    }
+  }
+  ~Client() { ::close(_fd); }
+
+  Client(const Client &) = delete;
+  Client &operator=(const Client &) = delete;
+  Client(Client &&) = delete;
+  Client &operator=(Client &&) = delete;
+
+  void send(const std::string &lines) const {
+    if (::send(_fd, lines.data(), lines.size(), MSG_NOSIGNAL) !=
+        static_cast<ssize_t>(lines.size())) {
+      throw std::runtime_error("Cannot send to the server");
+    }
+  }
+
+  std::string reply() {
+    for (;;) {
+      if (const auto end = _buffer.find('\n'); end != std::string::npos) {
+        auto line = _buffer.substr(0, end);
+        _buffer.erase(0, end + 1);
+        return line;
+      }
+      char chunk[256];
+      const auto count = ::read(_fd, chunk, sizeof(chunk));
+      if (count <= 0) {
+        throw std::runtime_error("The server closed the connection");
+      }
+      _buffer.append(chunk, static_cast<std::size_t>(count));
+    }
+  }
+
+  std::string request(const std::string &line) {
+    send(line + '\n');
+    return reply();
+  }
+
+ private:
+  int _fd;
+  std::string _buffer;
+};
+
+/// play `solution` in a new session on `client`; the guesses, or 0 if lost
+int play(Client *client, const std::string &solution) {
+  const auto created = client->request("new");
+  const auto session = created.substr(3);
+  for (int turn = 1; turn <= 10; ++turn) {
+    const auto guess = client->request("guess " + session);
+    if (guess.rfind("ok ", 0) != 0) {
+      std::cout << "guess: " << guess << '\n';
+      return 0;
+    }
+    const auto feedback = Feedback::feedback_string(guess.substr(3), solution);
+    if (feedback == "ggggg") {
+      return client->request("close " + session) == "ok" ? turn : 0;
+    }
+    if (client->request("feedback " + session + ' ' + feedback) != "ok") {
+      return 0;
+    }
+  }
+  return 0;
+}
+
+} // namespace
+
+int main() {
+  const std::string socket_path{"daemon_test.sock"};
+  const auto dictionary = Dictionary::shared_default();
+  const auto solutions = dictionary->all_solutions().to_strings();
+  std::size_t failures{};
+
+  Server server{dictionary, std::make_shared<ThreadPool>(3), nullptr, nullptr};
+  server.listen(socket_path);
+  std::thread loop{[&server]() { server.run(); }};
+
+  {
+    // two clients, each playing its games in turn
+    std::vector<std::thread> clients;
+    std::vector<int> guesses(2);
+    for (std::size_t c = 0; c < guesses.size(); ++c) {
+      clients.emplace_back([&, c]() {
+        Client client{socket_path};
+        for (std::size_t g = 0; g < 5; ++g) {
+          const auto turns =
+              play(&client, solutions[(c * 5 + g) * 97 % solutions.size()]);
+          guesses[c] = turns == 0 || guesses[c] < 0 ? -1 : guesses[c] + turns;
+        }
+      });
+    }
+    for (auto &client : clients) {
+      client.join();
+    }
+    for (const auto total : guesses) {
+      std::cout << "five games in " << total << " guesses\n";
+      failures += total > 0 ? 0 : 1;
+    }
+  }
+
+  {
+    // requests for two sessions pipelined: replies come in request order,
+    // even for requests queued behind their session's running guess
+    Client client{socket_path};
+    client.send("new\nnew\n");
+    const auto first = client.reply().substr(3);
+    const auto second = client.reply().substr(3);
+    client.send("guess " + first + "\nguess " + second + "\nfeedback " +
+                first + " xxxxx\nclose " + second + '\n');
+    const auto guess = client.reply();
+    const bool ok = guess.rfind("ok ", 0) == 0 && client.reply() == guess &&
+                    client.reply() == "ok" && client.reply() == "ok";
+    std::cout << "pipelined: " << (ok ? "in order" : "OUT OF ORDER") << '\n';
+    failures += ok ? 0 : 1;
+
+    // feedback no solution fits: every letter but the last in place, and
+    // the last elsewhere
+    const auto third = client.request("new").substr(3);
+    const auto opening = client.request("guess " + third);
+    const auto accepted = client.request("feedback " + third + " ggggy");
+    std::cout << opening << ", " << accepted << '\n';
+    for (const auto &line :
+         {std::string{"feedback 999 xxxxx"}, std::string{"guess"},
+          "guess " + third, "feedback " + third + " xxqxx",
+          "frobnicate " + third}) {
+      const auto reply = client.request(line);
+      std::cout << line << " -> " << reply << '\n';
+      failures += reply.rfind("error ", 0) == 0 ? 0 : 1;
+    }
+  }
+
+  {
+    // clients hanging up while their guesses run, and one sending requests
+    // without reading the replies, are closed; the server goes on serving
+    for (int i = 0; i < 20; ++i) {
+      Client client{socket_path};
+      client.send("guess " + client.request("new").substr(3) + '\n');
+    }
+    bool closed{};
+    {
+      Client client{socket_path};
+      std::string requests;
+      for (int i = 0; i < 1000; ++i) {
+        requests += "frobnicate\n";
+      }
+      try {
+        for (int i = 0; i < 1000; ++i) {
+          client.send(requests);
+        }
+      } catch (const std::runtime_error &) {
+        closed = true;
+      }
+    }
+    const auto reply = Client{socket_path}.request("new");
+    std::cout << "unread replies " << (closed ? "closed" : "NOT CLOSED")
+              << " the connection, then: " << reply << '\n';
+    failures += closed && reply.rfind("ok ", 0) == 0 ? 0 : 1;
+  }
+
+  // closed connections take their sessions with them; a last request makes
+  // sure the server has seen the others close
+  Client{socket_path}.request("frobnicate");
+  server.stop();
+  loop.join();
+  std::cout << server.session_count() << " sessions left open\n";
+  failures += server.session_count() == 0 ? 0 : 1;
+  std::remove(socket_path.c_str());
+
+  std::cout << failures << " failures\n";
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,181 @@
+#include "dictionary.h"
+#include "feedback.h"
+#include "wordle_solver.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// whether `mapped` holds exactly the words and patterns of `expected`
+bool same(const Dictionary &expected, const Dictionary &mapped) {
+  const auto &lhs = expected.patterns();
+  const auto &rhs = mapped.patterns();
+  return expected.all_words() == mapped.all_words() &&
+         expected.all_solutions() == mapped.all_solutions() &&
+         expected.fingerprint() == mapped.fingerprint() &&
+         lhs.guesses() == rhs.guesses() &&
+         lhs.solution_rows() == rhs.solution_rows() &&
+         std::memcmp(lhs.data(), rhs.data(),
+                     lhs.guess_count() * lhs.solution_count()) == 0 &&
+         mapped.all_words().index_of(expected.all_words()[42]) == 42;
+}
+
+/// whether Dictionary::map rejects `file_name`
+bool rejected(const std::string &file_name) {
+  try {
+    static_cast<void>(Dictionary::map(file_name));
+  } catch (const std::runtime_error &error) {
+    std::cout << "rejected: " << error.what() << '\n';
+    return true;
+  }
+  return false;
+}
+
+/// whether `load` throws std::invalid_argument for a word that doesn't fit
+template <typename Load> bool invalid(const std::string &what,
+                                      const Load &load) {
+  try {
+    load();
+  } catch (const std::invalid_argument &error) {
+    std::cout << "invalid " << what << ": " << error.what() << '\n';
+    return true;
+  }
+  std::cout << what << " accepted\n";
+  return false;
+}
+
+} // namespace
+
+int main() {
+  const auto dictionary = Dictionary::shared_default();
+  const std::string file_name{"dictionary_test.bin"};
+  std::size_t failures{};
+
+  for (const unsigned sections :
+       {0U, unsigned{Dictionary::letter_masks},
+        unsigned{Dictionary::pattern_table},
+        Dictionary::letter_masks | Dictionary::pattern_table}) {
+    dictionary->save(file_name, sections);
+    const auto start = Clock::now();
+    const auto mapped = Dictionary::map(file_name);
+    const auto elapsed = Clock::now() - start;
+    const bool ok = same(*dictionary, *mapped);
+    std::cout << "sections " << sections << ": mapped in "
+              << std::chrono::duration<double, std::micro>(elapsed).count()
+              << " us, " << (ok ? "identical" : "DIFFERENT") << '\n';
+    failures += ok ? 0 : 1;
+  }
+
+  {
+    const auto start = Clock::now();
+    const auto embedded = Dictionary::embedded();
+    const auto elapsed = Clock::now() - start;
+    const bool ok = same(*dictionary, *embedded);
+    std::cout << "embedded: built in "
+              << std::chrono::duration<double, std::milli>(elapsed).count()
+              << " ms, " << (ok ? "identical" : "DIFFERENT") << '\n';
+    failures += ok ? 0 : 1;
+  }
+
+  // seven-letter words have 64-bit keys; the file must hold only their
+  // letters and masks, so saving the same words gives the same bytes
+  {
+    std::vector<std::string> words;
+    for (const auto &word : dictionary->all_solutions().to_strings()) {
+      words.push_back(word + word.substr(0, 2));
+    }
+    const BasicWordList<7> list{words};
+    const auto read = [&file_name](const BasicWordList<7> &words) {
+      BasicDictionary<7>{words, words}.save(file_name);
+      std::ifstream in(file_name, std::ios::binary);
+      return std::string((std::istreambuf_iterator<char>(in)),
+                         std::istreambuf_iterator<char>());
+    };
+    const auto bytes = read(list);
+    auto copy = list;
+    copy.push_back(BasicPackedWord<7>{"zzzzzzz"});
+    static_cast<void>(read(copy));
+    const bool ok = read(list) == bytes &&
+                    BasicDictionary<7>::map(file_name)->all_words() == list;
+    std::cout << "seven letters: " << (ok ? "identical" : "DIFFERENT")
+              << '\n';
+    failures += ok ? 0 : 1;
+  }
+
+  // a solution changed to another word, and solutions pointing at each
+  // other's pattern rows
+  {
+    dictionary->save(file_name,
+                     Dictionary::letter_masks | Dictionary::pattern_table);
+    std::ifstream in(file_name, std::ios::binary);
+    const std::string bytes((std::istreambuf_iterator<char>(in)),
+                            std::istreambuf_iterator<char>());
+    // finds the first four of `values` and stores the second over the first
+    const auto corrupt = [&bytes, &file_name](const auto *values) {
+      constexpr auto size = sizeof(*values);
+      std::string run(4 * size, '\0');
+      std::memcpy(run.data(), values, run.size());
+      auto copy = bytes;
+      const auto at = copy.find(run);
+      if (at == std::string::npos) {
+        return false;
+      }
+      copy.replace(at, size, run, size, size);
+      std::ofstream(file_name, std::ios::binary | std::ios::trunc)
+          .write(copy.data(), static_cast<std::streamsize>(copy.size()));
+      return rejected(file_name);
+    };
+    failures += corrupt(dictionary->all_solutions().data()) ? 0 : 1;
+    failures +=
+        corrupt(dictionary->patterns().solution_rows().data()) ? 0 : 1;
+  }
+
+  // a file cut short, and one that isn't a dictionary at all
+  {
+    std::ifstream in(file_name, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)),
+                      std::istreambuf_iterator<char>());
+    std::ofstream(file_name, std::ios::binary | std::ios::trunc)
+        .write(bytes.data(), static_cast<std::streamsize>(bytes.size() / 2));
+  }
+  failures += rejected(file_name) ? 0 : 1;
+  std::ofstream(file_name, std::ios::trunc) << "tarse\n";
+  failures += rejected(file_name) ? 0 : 1;
+
+  // word lists saved on Windows load, and words that don't fit are rejected
+  std::ofstream(file_name, std::ios::trunc) << "tarse\r\n\nrefer\r\n";
+  const bool windows = WordleSolver::load_wordlist(file_name) ==
+                       std::vector<std::string>{"tarse", "refer"};
+  std::cout << "Windows line endings: " << (windows ? "loaded" : "WRONG")
+            << '\n';
+  failures += windows ? 0 : 1;
+  for (const std::string word : {"tars", "tarsed", "Tarse", "tars1"}) {
+    std::ofstream(file_name, std::ios::trunc) << "refer\n" << word << '\n';
+    failures += invalid("list with " + word, [&file_name] {
+                  static_cast<void>(WordleSolver::load_wordlist(file_name));
+                })
+                    ? 0
+                    : 1;
+    failures += invalid("WordList of " + word, [&word] {
+                  static_cast<void>(WordList{std::vector{word}});
+                })
+                    ? 0
+                    : 1;
+    failures += invalid("feedback for " + word, [&word] {
+                  static_cast<void>(Feedback::pattern(word, "refer"));
+                })
+                    ? 0
+                    : 1;
+  }
+  std::remove(file_name.c_str());
+
+  std::cout << failures << " failures\n";
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
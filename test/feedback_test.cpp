@@ -0,0 +1,183 @@
+#include "feedback.h"
+#include "feedback_batch.h"
+#include "wordle_solver.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <map>
+
+namespace {
+
+/// the game's rules, written for clarity rather than speed
+std::string reference_feedback(const std::string &guess,
+                               const std::string &solution) {
+  std::string outcome(guess.size(), 'x');
+  std::array<int, 256> unmatched{};
+  for (std::size_t i = 0; i < guess.size(); ++i) {
+    if (guess[i] == solution[i]) {
+      outcome[i] = 'g';
+    } else {
+      ++unmatched[static_cast<unsigned char>(solution[i])];
+    }
+  }
+  for (std::size_t i = 0; i < guess.size(); ++i) {
+    auto &count = unmatched[static_cast<unsigned char>(guess[i])];
+    if (outcome[i] != 'g' && count > 0) {
+      outcome[i] = 'y';
+      --count;
+    }
+  }
+  return outcome;
+}
+
+std::string code_string(const Feedback::Code &code) {
+  std::string outcome;
+  for (int i = WordleSolver::word_len - 1; i >= 0; --i) {
+    const auto bits = (code >> (i * Feedback::feedback_char_bits)).to_ulong();
+    outcome += (bits & 2U) != 0 ? 'g' : (bits & 1U) != 0 ? 'y' : 'x';
+  }
+  return outcome;
+}
+
+Feedback::Code reference_code(const std::string &feedback) {
+  Feedback::Code code;
+  for (std::size_t i = 0; i < feedback.size(); ++i) {
+    const auto bit = (feedback.size() - 1 - i) * Feedback::feedback_char_bits;
+    code.set(bit + 1, feedback[i] == 'g');
+    code.set(bit, feedback[i] == 'y');
+  }
+  return code;
+}
+
+/// `N`-letter words made from five-letter ones: prefixes when shorter, and
+/// when longer, the word followed by its own first letters, so repeated
+/// letters are common
+template <int N>
+std::vector<std::string> resized(const std::vector<std::string> &words) {
+  std::vector<std::string> result;
+  for (const auto &word : words) {
+    auto resized_word = word.substr(0, N);
+    while (resized_word.size() < static_cast<std::size_t>(N)) {
+      resized_word += word[resized_word.size() - word.size()];
+    }
+    result.push_back(resized_word);
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+/// BasicFeedback and FeedbackBatch for `N`-letter words against the
+/// reference, for a sample of guesses
+template <int N, typename Check>
+std::size_t check_length(const std::vector<std::string> &solutions,
+                         const Check &check) {
+  using Feedback = BasicFeedback<N>;
+  const auto words = resized<N>(solutions);
+  const BasicSolutionBlock<N> block{BasicWordList<N>{words}};
+  std::vector<typename Feedback::Pattern> batch(words.size());
+  constexpr std::size_t stride{16};
+
+  std::size_t pairs{};
+  for (std::size_t g = 0; g < words.size(); g += stride) {
+    const auto &guess = words[g];
+    FeedbackBatch::patterns(BasicPackedWord<N>{guess}, block, batch.data());
+    for (std::size_t s = 0; s < words.size(); ++s) {
+      const auto &solution = words[s];
+      const auto reference = reference_feedback(guess, solution);
+      const auto pattern = Feedback::to_pattern(reference);
+      check("to_pattern " + std::to_string(N), guess, solution, reference,
+            Feedback::to_string(pattern));
+      check("pattern " + std::to_string(N), guess, solution, reference,
+            Feedback::to_string(Feedback::pattern(guess, solution)));
+      check("FeedbackBatch " + std::to_string(N), guess, solution, reference,
+            Feedback::to_string(batch[s]));
+    }
+    pairs += words.size();
+  }
+  return pairs;
+}
+
+} // namespace
+
+int main() {
+  std::size_t failures{};
+  const auto check = [&failures](const std::string &what,
+                                 const std::string &guess,
+                                 const std::string &solution,
+                                 const std::string &expected,
+                                 const std::string &actual) {
+    if (expected != actual) {
+      if (++failures <= 10) {
+        std::cout << what << ": " << guess << " -> " << solution
+                  << " expected " << expected << ", got " << actual << '\n';
+      }
+    }
+  };
+
+  const std::map<std::pair<std::string, std::string>, std::string> known{
+      {{"tarse", "refer"}, "xxyxy"}, {{"nanny", "ninja"}, "gygxx"},
+      {{"speed", "abide"}, "xxyxy"}, {{"eerie", "there"}, "yxyxg"},
+      {{"llama", "hello"}, "yyxxx"}, {{"hello", "llama"}, "xxyyx"},
+      {{"geese", "eerie"}, "xgyxg"}, {{"abbey", "babes"}, "yyggx"}};
+  for (const auto &[words, expected] : known) {
+    const auto &[guess, solution] = words;
+    check("reference", guess, solution, expected,
+          reference_feedback(guess, solution));
+    check("feedback_string", guess, solution, expected,
+          Feedback::feedback_string(guess, solution));
+  }
+
+  const auto words = WordleSolver::load_wordlist("word_lists/all_words.txt");
+  const auto solutions =
+      WordleSolver::load_wordlist("word_lists/all_solutions.txt");
+  const SolutionBlock block{WordList{solutions}};
+  std::vector<Feedback::Pattern> batch(solutions.size());
+
+  std::vector<Feedback::Pattern> expected(solutions.size());
+
+  for (const auto &guess : words) {
+    for (std::size_t s = 0; s < solutions.size(); ++s) {
+      const auto &solution = solutions[s];
+      const auto reference = reference_feedback(guess, solution);
+      expected[s] = Feedback::to_pattern(reference);
+      if (Feedback::to_string(expected[s]) != reference) {
+        check("to_pattern", guess, solution, reference,
+              Feedback::to_string(expected[s]));
+      }
+      if (Feedback::pattern(guess, solution) != expected[s]) {
+        check("pattern", guess, solution, reference,
+              Feedback::to_string(Feedback::pattern(guess, solution)));
+      }
+      if (Feedback::feedback(guess, solution) != reference_code(reference)) {
+        check("feedback", guess, solution, reference,
+              code_string(Feedback::feedback(guess, solution)));
+      }
+    }
+    for (const auto isa :
+         {FeedbackBatch::Isa::scalar, FeedbackBatch::Isa::sse42,
+          FeedbackBatch::Isa::avx2}) {
+      if (isa > FeedbackBatch::best_isa()) {
+        continue;
+      }
+      FeedbackBatch::patterns(PackedWord{guess}, block, batch.data(), isa);
+      for (std::size_t s = 0; s < solutions.size(); ++s) {
+        if (batch[s] != expected[s]) {
+          check(std::string{"FeedbackBatch "} + FeedbackBatch::isa_name(isa),
+                guess, solutions[s], Feedback::to_string(expected[s]),
+                Feedback::to_string(batch[s]));
+        }
+      }
+    }
+  }
+
+  auto pairs = words.size() * solutions.size();
+  pairs += check_length<4>(solutions, check);
+  pairs += check_length<6>(solutions, check);
+  pairs += check_length<7>(solutions, check);
+  pairs += check_length<8>(solutions, check);
+
+  std::cout << pairs << " pairs checked, " << failures << " failures\n";
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,66 +1,831 @@
+#include "cancellation_token.h"
+#include "decision_tree.h"
+#include "dictionary.h"
 #include "feedback.h"
+#include "guess_cache.h"
+#include "multi_board_solver.h"
+#include "opening_book.h"
+#include "pattern_histogram.h"
+#include "thread_pool.h"
 #include "wordle_solver.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <sstream>
+#include <stdexcept>
 
-int main() {
-  const std::vector<std::string> solutions =
-      WordleSolver::load_wordlist("word_lists/all_solutions.txt");
+namespace {
 
-  constexpr std::size_t unsolved{0};
+using Clock = std::chrono::steady_clock;
+
+constexpr int unsolved{0};
+constexpr int max_guesses{10};
+
+struct Game {
+  int guesses{};             ///< guesses to solve, or `unsolved`
+  std::string played;        ///< every guess, one after the other
+  Clock::duration elapsed{}; ///< time spent by the solver
+  std::uint64_t skipped{};   ///< WordleSolver::skipped_evaluations
+  std::uint64_t updated{};   ///< scores from pattern counts carried over
+};
+
+/// changes the settings of a new solver before a game
+using Setup = std::function<void(WordleSolver *)>;
+
+/// play one game against `solution`
+Game play(WordleSolver *solver, const std::string &solution) {
   const std::string solved{"ggggg"};
+  Game game;
+  const auto start = Clock::now();
+  for (int i = 1; i <= max_guesses; ++i) {
+    const auto guess = solver->guess();
+    game.played += guess;
+    const auto feedback = Feedback::feedback_string(guess, solution);
+    if (feedback == solved) {
+      game.guesses = i;
+      break;
+    }
+    solver->accept_feedback(feedback);
+  }
+  game.elapsed = Clock::now() - start;
+  game.skipped = solver->skipped_evaluations();
+  game.updated = solver->partition_statistics().updates;
+  return game;
+}
+
+double milliseconds(const Clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/**
+ * @brief Solve every puzzle, games running concurrently on `pool`, each with a
+ *        single-threaded solver of its own
+ * @param setup Applied to every solver, or empty
+ * @return The games, in the order of `solutions`
+ */
+std::vector<Game> run_batch(ThreadPool *pool,
+                            const std::shared_ptr<const Dictionary> &dictionary,
+                            const std::vector<std::string> &solutions,
+                            const Setup &setup = {}) {
+  std::vector<Game> games(solutions.size());
+
+  std::cout << "solving " << solutions.size() << " puzzles on "
+            << pool->thread_count() << " threads\n";
+  const auto start = Clock::now();
+  pool->parallel_for(solutions.size(), 1,
+                     [&](const std::size_t first, const std::size_t last) {
+                       for (auto i = first; i < last; ++i) {
+                         WordleSolver solver{dictionary};
+                         solver.set_thread_count(1);
+                         if (setup) {
+                           setup(&solver);
+                         }
+                         games[i] = play(&solver, solutions[i]);
+                       }
+                     });
+  const auto duration = Clock::now() - start;
 
   std::map<int, int> guesses;
   guesses[unsolved] = 0;
   guesses[1] = 0;
-  std::size_t counter{};
+  std::vector<Clock::duration> latencies;
+  latencies.reserve(games.size());
+  for (const auto &game : games) {
+    ++guesses[game.guesses];
+    latencies.push_back(game.elapsed);
+  }
+  std::sort(latencies.begin(), latencies.end());
+  const auto percentile = [&latencies](const double fraction) {
+    const auto index = static_cast<std::size_t>(
+        fraction * static_cast<double>(latencies.size() - 1));
+    return milliseconds(latencies[index]);
+  };
+
+  double average{};
+  std::cout << '\n';
+  for (const auto &[score, freq] : guesses) {
+    std::cout << score << ' ' << freq;
+    if (score == unsolved) {
+      std::cout << " <- unsolved puzzles\n";
+    } else {
+      std::cout << '\n';
+    }
+    average += static_cast<double>(score) * static_cast<double>(freq) /
+               static_cast<double>(solutions.size());
+  }
+  std::cout << '\n';
+  std::cout << "Average guesses-to-solve: " << average << '\n';
+  std::cout << "Test duration: "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+                   .count()
+            << " ms\n";
+  std::cout << "Puzzles per second: "
+            << static_cast<double>(solutions.size()) /
+                   std::chrono::duration<double>(duration).count()
+            << '\n';
+  std::uint64_t skipped{};
+  for (const auto &game : games) {
+    skipped += game.skipped;
+  }
+  std::cout << "Evaluations skipped by bounds: " << skipped << '\n';
+  std::cout << "Game latency: p50 " << percentile(0.50) << " ms, p90 "
+            << percentile(0.90) << " ms, p99 " << percentile(0.99)
+            << " ms, max " << milliseconds(latencies.back()) << " ms\n";
+
+  return games;
+}
+
+std::size_t count_unsolved(const std::vector<Game> &games) {
+  return static_cast<std::size_t>(
+      std::count_if(games.begin(), games.end(),
+                    [](const Game &game) { return game.guesses == unsolved; }));
+}
+
+/**
+ * @return The number of games in which the solver guessed differently from
+ *         the `expected` games
+ */
+std::size_t count_mismatches(const std::string &label,
+                             const std::vector<std::string> &solutions,
+                             const std::vector<Game> &games,
+                             const std::vector<Game> &expected) {
+  std::size_t mismatches{};
+  for (std::size_t i = 0; i < games.size(); ++i) {
+    if (games[i].played != expected[i].played) {
+      std::cerr << solutions[i] << ": played " << games[i].played << ' '
+                << label << ", " << expected[i].played << " before\n";
+      ++mismatches;
+    }
+  }
+  return mismatches;
+}
+
+/**
+ * @brief Play every puzzle again with an opening book that went through a
+ *        save and load, and check each game goes as it did without it
+ * @return The number of games that went differently
+ */
+std::size_t run_book_batch(ThreadPool *pool,
+                           const std::shared_ptr<const Dictionary> &dictionary,
+                           const std::vector<std::string> &solutions,
+                           const std::vector<Game> &expected) {
+  constexpr int depth{3};
+  const std::string file_name{"opening_book_test.bin"};
+
+  std::cout << "\nbuilding a " << depth << "-turn opening book\n";
+  const auto start = Clock::now();
+  OpeningBook::build(dictionary, depth)->save(file_name);
+  const std::shared_ptr<const OpeningBook> book =
+      OpeningBook::load(file_name, *dictionary);
+  std::remove(file_name.c_str());
+  std::cout << book->size() << " guesses in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   Clock::now() - start)
+                   .count()
+            << " ms\n";
 
-  const auto start = std::chrono::high_resolution_clock::now();
+  const auto games =
+      run_batch(pool, dictionary, solutions, [&book](WordleSolver *solver) {
+        solver->set_opening_book(book);
+      });
+  return count_mismatches("with the opening book", solutions, games, expected);
+}
+
+/**
+ * @brief Play every puzzle again scoring every word, and check that the
+ *        bounded search made the same guesses
+ * @return The number of games that went differently
+ */
+std::size_t run_exhaustive_batch(
+    ThreadPool *pool, const std::shared_ptr<const Dictionary> &dictionary,
+    const std::vector<std::string> &solutions,
+    const std::vector<Game> &expected) {
+  std::cout << "\nscoring every word\n";
+  const auto games =
+      run_batch(pool, dictionary, solutions, [](WordleSolver *solver) {
+        solver->set_search(WordleSolver::Search::exhaustive);
+      });
+  return count_mismatches("scoring every word", solutions, games, expected);
+}
+
+/**
+ * @brief Play every puzzle again without carrying pattern counts from turn
+ *        to turn, and check the games go as they did with them, some of
+ *        whose scores came from counts carried over
+ * @return The number of games that went differently, or 1 if no score came
+ *         from carried counts
+ */
+std::size_t run_untracked_batch(
+    ThreadPool *pool, const std::shared_ptr<const Dictionary> &dictionary,
+    const std::vector<std::string> &solutions,
+    const std::vector<Game> &expected) {
+  std::uint64_t updated{};
+  for (const auto &game : expected) {
+    updated += game.updated;
+  }
+  std::cout << "\nwithout carrying pattern counts; " << updated
+            << " scores came from carried counts before\n";
+  const auto games =
+      run_batch(pool, dictionary, solutions, [](WordleSolver *solver) {
+        solver->set_partition_tracking(false);
+      });
+  return count_mismatches("without carried counts", solutions, games,
+                          expected) +
+         (updated == 0 ? 1 : 0);
+}
+
+/**
+ * @brief Play every puzzle twice more with one guess cache shared by every
+ *        solver, and check the games go as they did without it
+ * @return The number of games that went differently
+ */
+std::size_t run_cache_batch(ThreadPool *pool,
+                            const std::shared_ptr<const Dictionary> &dictionary,
+                            const std::vector<std::string> &solutions,
+                            const std::vector<Game> &expected) {
+  const auto cache = std::make_shared<GuessCache>();
+  const Setup setup = [&cache](WordleSolver *solver) {
+    solver->set_guess_cache(cache);
+  };
+  std::size_t mismatches{};
+  for (const auto *pass : {"cold", "warm"}) {
+    std::cout << "\nwith a " << pass << " guess cache\n";
+    const auto games = run_batch(pool, dictionary, solutions, setup);
+    mismatches += count_mismatches(std::string{"with a "} + pass + " cache",
+                                   solutions, games, expected);
+    const auto statistics = cache->statistics();
+    std::cout << "Cache: " << statistics.hits << " hits, "
+              << statistics.misses << " misses, " << statistics.size
+              << " entries\n";
+  }
+  return mismatches;
+}
+
+/**
+ * @brief Play every puzzle again without a pattern table, the solvers
+ *        sharing feedback rows computed on demand, and check the games go as
+ *        they did with it and the rows keep to their budget
+ * @return The number of games that went differently, budgets overrun and
+ *         builds that should have thrown
+ */
+std::size_t run_on_demand_batch(
+    ThreadPool *pool, const std::shared_ptr<const Dictionary> &dictionary,
+    const std::vector<std::string> &solutions,
+    const std::vector<Game> &expected) {
+  const auto on_demand = std::make_shared<const Dictionary>(
+      dictionary->all_words(), dictionary->all_solutions(),
+      Dictionary::Storage::on_demand);
+  constexpr std::size_t budget{1U << 20U};
+  const auto rows = std::make_shared<FeedbackRows>(budget);
 
-  std::cout << "progress: ";
+  std::cout << "\ncomputing feedback on demand\n";
+  const auto games =
+      run_batch(pool, on_demand, solutions, [&rows](WordleSolver *solver) {
+        solver->set_feedback_rows(rows);
+      });
+  auto failures = count_mismatches("on demand", solutions, games, expected);
+  const auto statistics = rows->statistics();
+  std::cout << "Feedback rows: hit rate " << statistics.hit_rate() << ", "
+            << statistics.misses << " computed, " << statistics.evictions
+            << " evicted, " << statistics.bytes << " of " << budget
+            << " bytes held\n";
+  if (statistics.bytes > budget) {
+    std::cerr << "feedback rows overran their budget\n";
+    ++failures;
+  }
+
+  try {
+    static_cast<void>(OpeningBook::build(on_demand, 1));
+    std::cerr << "built an opening book without a pattern table\n";
+    ++failures;
+  } catch (const std::invalid_argument &) {
+  }
+  return failures;
+}
+
+/**
+ * @brief Play every puzzle again in hard mode, and check every guess keeps
+ *        the greens and uses the revealed letters of the guesses before it
+ * @return The number of games that broke the rule or went unsolved
+ */
+std::size_t run_hard_mode_batch(
+    ThreadPool *pool, const std::shared_ptr<const Dictionary> &dictionary,
+    const std::vector<std::string> &solutions) {
+  constexpr auto len = static_cast<std::size_t>(WordleSolver::word_len);
+
+  std::cout << "\nplaying in hard mode\n";
+  const auto games =
+      run_batch(pool, dictionary, solutions, [](WordleSolver *solver) {
+        solver->set_hard_mode(true);
+      });
+
+  const auto breaks_rule = [](const std::string &guess,
+                              const std::string &earlier,
+                              const std::string &hints) {
+    std::map<char, int> revealed;
+    for (std::size_t i = 0; i < len; ++i) {
+      if (hints[i] == 'g' && guess[i] != earlier[i]) {
+        return true;
+      }
+      revealed[earlier[i]] += static_cast<int>(hints[i] != 'x');
+    }
+    return std::any_of(revealed.begin(), revealed.end(),
+                       [&guess](const auto &entry) {
+                         return std::count(guess.begin(), guess.end(),
+                                           entry.first) < entry.second;
+                       });
+  };
+  std::size_t failures{count_unsolved(games)};
+  for (std::size_t game = 0; game < games.size(); ++game) {
+    const auto &played = games[game].played;
+    for (std::size_t turn = 1; turn * len < played.size(); ++turn) {
+      const auto guess = played.substr(turn * len, len);
+      bool broken{};
+      for (std::size_t before = 0; before < turn; ++before) {
+        const auto earlier = played.substr(before * len, len);
+        const auto hints = Feedback::feedback_string(earlier, solutions[game]);
+        broken = broken || breaks_rule(guess, earlier, hints);
+      }
+      if (broken) {
+        std::cerr << solutions[game] << ": " << guess
+                  << " breaks the hard mode rule in " << played << '\n';
+        ++failures;
+        break;
+      }
+    }
+  }
+  return failures;
+}
+
+/**
+ * @brief Play every puzzle with a decision tree that went through a save and
+ *        load, and check it solves them all in the guesses it promises
+ * @return The number of puzzles that went differently from the tree
+ */
+std::size_t run_tree_batch(ThreadPool *pool,
+                           const std::shared_ptr<const Dictionary> &dictionary,
+                           const std::vector<std::string> &solutions) {
+  constexpr std::size_t candidates{2};
+  const std::string file_name{"decision_tree_test.bin"};
+
+  std::cout << "\nbuilding a decision tree over " << candidates
+            << " guesses a node\n";
+  const auto start = Clock::now();
+  DecisionTree::build(dictionary, candidates,
+                      DecisionTree::Objective::average, pool)
+      ->save(file_name);
+  const std::shared_ptr<const DecisionTree> tree =
+      DecisionTree::load(file_name, *dictionary);
+  std::remove(file_name.c_str());
+  std::cout << tree->size() << " nodes in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   Clock::now() - start)
+                   .count()
+            << " ms\n";
+
+  const auto games =
+      run_batch(pool, dictionary, solutions, [&tree](WordleSolver *solver) {
+        solver->set_decision_tree(tree);
+      });
+  std::uint64_t total{};
+  int worst{};
+  for (const auto &game : games) {
+    total += static_cast<std::uint64_t>(game.guesses);
+    worst = std::max(worst, game.guesses);
+  }
+  if (total != tree->total_guesses() ||
+      worst != static_cast<int>(tree->max_guesses())) {
+    std::cerr << "the tree took " << total << " guesses, " << worst
+              << " at most; it promised " << tree->total_guesses() << ", "
+              << tree->max_guesses() << " at most\n";
+    return count_unsolved(games) + 1;
+  }
+  return count_unsolved(games);
+}
+
+/**
+ * @brief Play every eighth puzzle again looking two guesses ahead, with a
+ *        budget generous enough that no word is passed over
+ * @return 1 if that took more guesses on average than `expected`, else 0
+ */
+std::size_t run_lookahead_batch(
+    ThreadPool *pool, const std::shared_ptr<const Dictionary> &dictionary,
+    const std::vector<std::string> &solutions,
+    const std::vector<Game> &expected) {
+  constexpr std::size_t step{8};
+  constexpr std::size_t candidates{10};
+
+  std::vector<std::string> sample;
+  double expected_average{};
+  for (std::size_t i = 0; i < solutions.size(); i += step) {
+    sample.push_back(solutions[i]);
+    expected_average += expected[i].guesses;
+  }
+  expected_average /= static_cast<double>(sample.size());
+
+  std::cout << "\nlooking ahead from the best " << candidates
+            << " words, every " << step << "th puzzle\n";
+  const auto games =
+      run_batch(pool, dictionary, sample, [](WordleSolver *solver) {
+        solver->set_lookahead(candidates, std::chrono::minutes{1});
+      });
+  double average{};
+  for (const auto &game : games) {
+    average += game.guesses;
+  }
+  average /= static_cast<double>(games.size());
+  std::cout << "Without lookahead: " << expected_average << '\n';
+
+  // with no time, a second turn's lookahead gives up on every word, and its
+  // fallback to the best entropy mustn't be cached for the next solver
+  std::size_t failures{count_unsolved(games) +
+                       (average > expected_average ? 1 : 0)};
   for (const auto &solution : solutions) {
-    WordleSolver solver;
-    std::string guess;
-    std::string feedback;
+    WordleSolver solver{dictionary};
+    solver.set_lookahead(candidates, std::chrono::milliseconds{0});
+    const auto cache = std::make_shared<GuessCache>();
+    solver.set_guess_cache(cache);
+    solver.accept_feedback(
+        Feedback::feedback_string(solver.guess(), solution));
+    if (solver.remaining() < 100) {
+      continue;
+    }
+    static_cast<void>(solver.guess());
+    if (cache->statistics().insertions != 0) {
+      std::cerr << solution << ": cached a lookahead cut short\n";
+      ++failures;
+    }
+    break;
+  }
+  return failures;
+}
+
+/**
+ * @brief Play a traced game on two threads, and check the trace accounts for
+ *        each turn and exports as Chrome trace events
+ * @return The number of inconsistencies found
+ */
+std::size_t check_tracing(const std::shared_ptr<const Dictionary> &dictionary,
+                          const std::string &solution) {
+  WordleSolver solver{dictionary};
+  solver.set_thread_count(2);
+  solver.set_tracing(true);
+  const auto game = play(&solver, solution);
+  const auto &trace = solver.trace();
+
+  std::size_t failures{};
+  const auto fail = [&failures](const std::string &what) {
+    std::cerr << "trace: " << what << '\n';
+    ++failures;
+  };
+  if (trace.size() != static_cast<std::size_t>(game.guesses)) {
+    fail(std::to_string(trace.size()) + " turns for " +
+         std::to_string(game.guesses) + " guesses");
+  }
+  for (std::size_t t = 0; t < trace.size(); ++t) {
+    const auto &turn = trace[t];
+    std::uint64_t words{};
+    for (const auto &chunk : turn.chunks) {
+      words += chunk.words;
+    }
+    std::cout << "turn " << t + 1 << ' ' << turn.guess << ": "
+              << turn.candidates_before << " -> " << turn.candidates_after
+              << " candidates, " << turn.evaluations << " evaluations in "
+              << turn.chunks.size() << " chunks, "
+              << milliseconds(turn.guess_phase.duration) << " ms\n";
+    if (turn.guess != game.played.substr(t * WordleSolver::word_len,
+                                         WordleSolver::word_len)) {
+      fail("turn " + std::to_string(t + 1) + " has the wrong guess");
+    }
+    if (words != turn.evaluations ||
+        (t + 1 < trace.size() &&
+         turn.candidates_after > turn.candidates_before)) {
+      fail("turn " + std::to_string(t + 1) + " doesn't add up");
+    }
+  }
+  if (trace.size() < 2 || trace[1].evaluations == 0) {
+    fail("the second guess wasn't searched");
+  }
+
+  std::ostringstream json;
+  write_chrome_trace(json, trace);
+  const auto text = json.str();
+  if (text.find("\"traceEvents\"") == std::string::npos ||
+      text.find("\"name\": \"chunk\"") == std::string::npos ||
+      std::count(text.begin(), text.end(), '{') !=
+          std::count(text.begin(), text.end(), '}')) {
+    fail("malformed Chrome trace");
+  }
+
+  solver.reset();
+  if (!solver.trace().empty()) {
+    fail("reset kept the trace");
+  }
+  return failures;
+}
+
+/**
+ * @brief Play with deadlines: one far off must give the guesses guess()
+ *        gives, and one already passed, or a cancelled token, the best of
+ *        a partial search, which stays out of the cache
+ * @return The number of wrong guesses or coverage reports
+ */
+std::size_t check_anytime(const std::shared_ptr<const Dictionary> &dictionary,
+                          const std::vector<std::string> &solutions) {
+  const std::string solved(WordleSolver::word_len, 'g');
+  std::size_t failures{};
+  const auto fail = [&failures](const std::string &solution,
+                                const std::string &what) {
+    std::cerr << solution << ": " << what << '\n';
+    ++failures;
+  };
 
-    for (int i = 1; i <= 10; ++i) {
-      guess = solver.guess();
-      feedback = Feedback::feedback_string(guess, solution);
+  // no time limit to speak of: complete, and the same as guess()
+  for (std::size_t s = 0; s < solutions.size(); s += 97) {
+    WordleSolver expected{dictionary};
+    WordleSolver anytime{dictionary};
+    for (int turn = 1; turn <= max_guesses; ++turn) {
+      const auto guess = expected.guess();
+      const auto timed = anytime.guess(Clock::now() + std::chrono::hours{1});
+      if (timed.word != guess || !timed.complete ||
+          timed.covered != timed.words) {
+        fail(solutions[s], "guessed " + timed.word + " instead of " + guess);
+        break;
+      }
+      const auto feedback = Feedback::feedback_string(guess, solutions[s]);
+      if (feedback == solved) {
+        break;
+      }
+      expected.accept_feedback(feedback);
+      anytime.accept_feedback(feedback);
+    }
+  }
+
+  // out of time on every search, or cancelled before it starts
+  const auto cache = std::make_shared<GuessCache>();
+  CancellationToken cancelled;
+  cancelled.cancel();
+  std::size_t partial{};
+  std::size_t words{};
+  std::size_t covered{};
+  std::size_t unsolved_games{};
+  for (std::size_t s = 0; s < solutions.size(); s += 97) {
+    WordleSolver solver{dictionary};
+    solver.set_guess_cache(cache);
+    const auto *token = s % 2 == 0 ? &cancelled : nullptr;
+    int turn = 1;
+    for (; turn <= max_guesses; ++turn) {
+      const auto timed = solver.guess(Clock::now(), token);
+      if (timed.words != 0 && timed.covered == 0) {
+        fail(solutions[s], "scored nothing");
+      }
+      partial += timed.complete ? 0 : 1;
+      words += timed.words;
+      covered += timed.covered;
+      const auto feedback = Feedback::feedback_string(timed.word,
+                                                      solutions[s]);
       if (feedback == solved) {
-        ++guesses[i];
         break;
       }
       solver.accept_feedback(feedback);
     }
-    if (feedback != solved) {
-      ++guesses[unsolved];
+    unsolved_games += turn > max_guesses ? 1 : 0;
+  }
+  std::cout << "\nwith no time: " << partial << " partial searches, "
+            << covered << " of " << words << " words covered, "
+            << cache->statistics().size << " searches cached, "
+            << unsolved_games << " games over " << max_guesses
+            << " guesses\n";
+  if (partial == 0) {
+    fail("every solution", "no search was cut short");
+  }
+
+  // the cache got only complete searches, so it can't change a game
+  WordleSolver cached{dictionary};
+  cached.set_guess_cache(cache);
+  WordleSolver uncached{dictionary};
+  for (int turn = 1; turn <= max_guesses; ++turn) {
+    const auto guess = uncached.guess();
+    if (cached.guess() != guess) {
+      fail(solutions[0], "the cache kept a partial search");
+      break;
     }
-    ++counter;
-    if (counter % 100 == 0) {
-      std::cout << '.';
-      std::cout.flush();
+    const auto feedback = Feedback::feedback_string(guess, solutions[0]);
+    if (feedback == solved) {
+      break;
     }
+    cached.accept_feedback(feedback);
+    uncached.accept_feedback(feedback);
   }
-  std::cout << "noice!\n\n";
 
-  const auto end = std::chrono::high_resolution_clock::now();
-  const auto duration =
-      std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+  // guesses that skipped the lookahead mustn't stand in for those that use
+  // it: a solver looking ahead shares a cache with one playing to deadlines
+  const auto lookahead_cache = std::make_shared<GuessCache>();
+  for (std::size_t s = 0; s < solutions.size(); s += 97) {
+    WordleSolver timed{dictionary};
+    WordleSolver ahead{dictionary};
+    WordleSolver expected{dictionary};
+    for (auto *solver : {&timed, &ahead, &expected}) {
+      solver->set_lookahead(10, std::chrono::seconds{100});
+    }
+    timed.set_guess_cache(lookahead_cache);
+    ahead.set_guess_cache(lookahead_cache);
+    bool timed_solved{};
+    for (int turn = 1; turn <= max_guesses; ++turn) {
+      // the deadline's game goes its own way; it only fills the cache
+      if (!timed_solved) {
+        const auto word =
+            timed.guess(Clock::now() + std::chrono::hours{1}).word;
+        const auto feedback = Feedback::feedback_string(word, solutions[s]);
+        timed_solved = feedback == solved;
+        if (!timed_solved) {
+          timed.accept_feedback(feedback);
+        }
+      }
+      const auto guess = expected.guess();
+      if (ahead.guess() != guess) {
+        fail(solutions[s], "a deadline's guess replaced the lookahead's");
+        break;
+      }
+      const auto feedback = Feedback::feedback_string(guess, solutions[s]);
+      if (feedback == solved) {
+        break;
+      }
+      ahead.accept_feedback(feedback);
+      expected.accept_feedback(feedback);
+    }
+  }
+  return failures;
+}
+
+/// `N`-letter words made from five-letter ones: prefixes when shorter, and
+/// when longer, the word followed by its own first letters
+template <int N>
+std::vector<std::string> resized(const std::vector<std::string> &words) {
+  std::vector<std::string> result;
+  for (const auto &word : words) {
+    auto resized_word = word.substr(0, N);
+    while (resized_word.size() < static_cast<std::size_t>(N)) {
+      resized_word += word[resized_word.size() - word.size()];
+    }
+    result.push_back(resized_word);
+  }
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+/**
+ * @brief Solve every puzzle of a dictionary of `N`-letter words, which has no
+ *        fixed opening, with a two-turn opening book built for it
+ * @return The number of puzzles not solved
+ */
+template <int N>
+std::size_t run_length_batch(ThreadPool *pool,
+                             const std::vector<std::string> &solutions) {
+  using Solver = BasicWordleSolver<N>;
+  using Feedback = typename Solver::Feedback;
+  using WordList = typename Solver::WordList;
+  const auto words = resized<N>(solutions);
+  const auto dictionary = std::make_shared<const typename Solver::Dictionary>(
+      WordList{words}, WordList{words});
+  const std::shared_ptr<const typename Solver::OpeningBook> book =
+      Solver::OpeningBook::build(dictionary, 2);
+
+  std::vector<int> guesses(words.size(), unsolved);
+  const auto start = Clock::now();
+  pool->parallel_for(
+      words.size(), 1, [&](const std::size_t first, const std::size_t last) {
+        for (auto s = first; s < last; ++s) {
+          Solver solver{dictionary};
+          solver.set_thread_count(1);
+          solver.set_opening_book(book);
+          for (int i = 1; i <= max_guesses; ++i) {
+            const auto guess = solver.guess();
+            const auto feedback = Feedback::feedback_string(guess, words[s]);
+            if (feedback == std::string(N, 'g')) {
+              guesses[s] = i;
+              break;
+            }
+            solver.accept_feedback(feedback);
+          }
+        }
+      });
+
   double average{};
+  for (const auto count : guesses) {
+    average += static_cast<double>(count) / static_cast<double>(words.size());
+  }
+  const auto failures = static_cast<std::size_t>(
+      std::count(guesses.begin(), guesses.end(), unsolved));
+  std::cout << '\n'
+            << words.size() << " puzzles of " << N << " letters, opening "
+            << book->find({}).value().to_string() << ": average " << average
+            << " guesses, " << failures << " unsolved, "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   Clock::now() - start)
+                   .count()
+            << " ms\n";
+  return failures;
+}
+
+/**
+ * @brief Play `games` multi-board games of `boards` boards, the boards'
+ *        words spread over the solutions
+ * @param limit The guesses the game allows
+ * @return The number of games not solved within `limit` guesses
+ */
+std::size_t run_multi_board_batch(
+    const std::shared_ptr<const Dictionary> &dictionary,
+    const std::vector<std::string> &solutions, const std::size_t boards,
+    const std::size_t games, const int limit) {
+  constexpr int max_multi_board_guesses{30};
+  std::map<int, int> guesses;
+  std::size_t failures{};
+  const auto start = Clock::now();
+  MultiBoardSolver solver{dictionary, boards};
+  for (std::size_t game = 0; game < games; ++game) {
+    std::vector<std::string> words;
+    for (std::size_t board = 0; board < boards; ++board) {
+      const auto index = (game * boards + board) * 7 % solutions.size();
+      words.push_back(solutions[index]);
+    }
+    solver.reset();
+    int count{};
+    while (!solver.all_solved() && count < max_multi_board_guesses) {
+      const auto guess = solver.guess();
+      ++count;
+      std::vector<std::string> feedback;
+      for (std::size_t board = 0; board < boards; ++board) {
+        feedback.push_back(Feedback::feedback_string(guess, words[board]));
+      }
+      solver.accept_feedback(feedback);
+    }
+    ++guesses[solver.all_solved() ? count : unsolved];
+    if (!solver.all_solved() || count > limit) {
+      ++failures;
+    }
+  }
 
+  double average{};
   for (const auto &[score, freq] : guesses) {
-    std::cout << score << ' ' << freq;
-    if (score == 0) {
-      std::cout << " <- unsolved puzzles\n";
+    average += static_cast<double>(score) * static_cast<double>(freq) /
+               static_cast<double>(games);
+  }
+  std::cout << '\n'
+            << games << " games of " << boards << " boards: average "
+            << average << " guesses, most " << guesses.rbegin()->first << ", "
+            << failures << " over " << limit << ", "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(
+                   Clock::now() - start)
+                   .count()
+            << " ms\n";
+  return failures;
+}
+
+} // namespace
+
+/**
+ * Usage: wordle-solver-test [--threads N]
+ *
+ * --threads N  Games to run at once; defaults to one per core
+ */
+int main(int argc, char *argv[]) {
+  unsigned thread_count{};
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+      thread_count = static_cast<unsigned>(std::stoul(argv[++i]));
     } else {
-      std::cout << '\n';
+      std::cerr << "usage: " << argv[0] << " [--threads N]\n";
+      return EXIT_FAILURE;
     }
-    average += static_cast<double>(score) * static_cast<double>(freq) /
-               static_cast<double>(solutions.size());
   }
-  std::cout << '\n';
-  std::cout << "Average guesses-to-solve: " << average << '\n';
-  std::cout << "Test duration: " << duration.count() << " ms\n";
+
+  const auto dictionary = Dictionary::shared_default();
+  const auto solutions = dictionary->all_solutions().to_strings();
+
+  ThreadPool pool{thread_count};
+  const auto games = run_batch(&pool, dictionary, solutions);
+  const auto failures =
+      count_unsolved(games) +
+      run_exhaustive_batch(&pool, dictionary, solutions, games) +
+      run_untracked_batch(&pool, dictionary, solutions, games) +
+      run_cache_batch(&pool, dictionary, solutions, games) +
+      run_on_demand_batch(&pool, dictionary, solutions, games) +
+      run_book_batch(&pool, dictionary, solutions, games) +
+      run_lookahead_batch(&pool, dictionary, solutions, games) +
+      run_tree_batch(&pool, dictionary, solutions) +
+      run_hard_mode_batch(&pool, dictionary, solutions) +
+      run_length_batch<4>(&pool, solutions) +
+      run_length_batch<6>(&pool, solutions) +
+      run_multi_board_batch(dictionary, solutions, 4, 100, 9) +
+      run_multi_board_batch(dictionary, solutions, 8, 50, 13) +
+      check_tracing(dictionary, solutions[3]) +
+      check_anytime(dictionary, solutions);
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,84 @@
+#include "decision_tree.h"
+#include "dictionary.h"
+#include "thread_pool.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+namespace {
+
+/// stores `text` in `number` if all of it is a number of that type
+template <typename Number> bool parse_number(const char *text, Number *number) {
+  const auto *last = text + std::strlen(text);
+  Number parsed{};
+  const auto [end, error] = std::from_chars(text, last, parsed);
+  if (error != std::errc{} || end != last) {
+    return false;
+  }
+  *number = parsed;
+  return true;
+}
+
+} // namespace
+
+/**
+ * Usage: wordle-decision-tree [--candidates K] [--objective average|worst]
+ *                             [--output FILE]
+ *
+ * --candidates K  Guesses tried at every node; defaults to 10. Each one more
+ *                 makes the search much slower
+ * --objective     Minimize the average or the worst case number of guesses;
+ *                 defaults to average
+ * --output FILE   Where to write the tree; defaults to
+ *                 word_lists/decision_tree.bin
+ */
+int main(int argc, char *argv[]) {
+  std::size_t candidates{10};
+  auto objective = DecisionTree::Objective::average;
+  std::string output{"word_lists/decision_tree.bin"};
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--candidates") == 0 && i + 1 < argc &&
+        parse_number(argv[i + 1], &candidates)) {
+      ++i;
+    } else if (std::strcmp(argv[i], "--objective") == 0 && i + 1 < argc &&
+               (std::strcmp(argv[i + 1], "average") == 0 ||
+                std::strcmp(argv[i + 1], "worst") == 0)) {
+      objective = std::strcmp(argv[++i], "worst") == 0
+                      ? DecisionTree::Objective::worst_case
+                      : DecisionTree::Objective::average;
+    } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--candidates K] [--objective average|worst]"
+                   " [--output FILE]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  try {
+    const auto dictionary = Dictionary::shared_default();
+    const auto start = std::chrono::steady_clock::now();
+    const auto tree = DecisionTree::build(dictionary, candidates, objective,
+                                          ThreadPool::shared().get());
+    tree->save(output);
+    const auto duration = std::chrono::steady_clock::now() - start;
+    const auto solutions = dictionary->all_solutions().size();
+    std::cout << "wrote " << tree->size() << " nodes to " << output << " in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+                     .count()
+              << " ms\n"
+              << "average guesses: "
+              << static_cast<double>(tree->total_guesses()) /
+                     static_cast<double>(solutions)
+              << " (" << tree->total_guesses() << " in all), worst case: "
+              << tree->max_guesses() << '\n';
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
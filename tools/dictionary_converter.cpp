@@ -0,0 +1,55 @@
+#include "dictionary.h"
+
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+/**
+ * Usage: wordle-dictionary [--words FILE] [--solutions FILE] [--output FILE]
+ *                          [--no-letter-masks] [--no-pattern-table]
+ *
+ * Converts the text word lists to the binary format of Dictionary::map.
+ *
+ * --words FILE         All valid guesses; defaults to word_lists/all_words.txt
+ * --solutions FILE     All possible solutions; defaults to
+ *                      word_lists/all_solutions.txt
+ * --output FILE        Defaults to word_lists/dictionary.bin
+ * --no-letter-masks    Store bare words; smaller, but copied on load
+ * --no-pattern-table   Leave the table out; much smaller, but rebuilt on load
+ */
+int main(int argc, char *argv[]) {
+  std::string words{"word_lists/all_words.txt"};
+  std::string solutions{"word_lists/all_solutions.txt"};
+  std::string output{"word_lists/dictionary.bin"};
+  unsigned sections{Dictionary::letter_masks | Dictionary::pattern_table};
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--words") == 0 && i + 1 < argc) {
+      words = argv[++i];
+    } else if (std::strcmp(argv[i], "--solutions") == 0 && i + 1 < argc) {
+      solutions = argv[++i];
+    } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else if (std::strcmp(argv[i], "--no-letter-masks") == 0) {
+      sections &= ~Dictionary::letter_masks;
+    } else if (std::strcmp(argv[i], "--no-pattern-table") == 0) {
+      sections &= ~Dictionary::pattern_table;
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--words FILE] [--solutions FILE] [--output FILE]"
+                   " [--no-letter-masks] [--no-pattern-table]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  try {
+    const auto dictionary = Dictionary::load(words, solutions);
+    dictionary->save(output, sections);
+    std::cout << "wrote " << dictionary->all_words().size() << " words and "
+              << dictionary->all_solutions().size() << " solutions to "
+              << output << '\n';
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,87 @@
+// Writes the word lists as a header of constexpr packed-word arrays, which
+// the compiler handles far more easily than thousands of string literals.
+// Only packed_word.h is used, so the library can be built from the output.
+
+#include "packed_word.h"
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// the packed keys of the words in `file_name`, or an empty list on error
+std::vector<std::uint32_t> read_keys(const std::string &file_name) {
+  std::vector<std::uint32_t> keys;
+  std::ifstream in(file_name);
+  if (!in.is_open()) {
+    std::cerr << "Failed to open file " << file_name << '\n';
+    return keys;
+  }
+  std::string line;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty()) {
+      continue;
+    }
+    try {
+      keys.push_back(PackedWord::parse(line).key());
+    } catch (const std::invalid_argument &error) {
+      std::cerr << file_name << ": " << error.what() << '\n';
+      return {};
+    }
+  }
+  return keys;
+}
+
+void write_array(std::ofstream &out, const std::string &name,
+                 const std::vector<std::uint32_t> &keys) {
+  constexpr int per_line{8};
+  out << "inline constexpr std::uint32_t " << name << "[] = {";
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    out << (i % per_line == 0 ? "\n   " : "") << " 0x" << std::hex
+        << std::setw(7) << std::setfill('0') << keys[i] << std::dec << ',';
+  }
+  out << "\n};\n\n";
+}
+
+} // namespace
+
+/**
+ * Usage: wordle-embed-word-lists ALL_WORDS ALL_SOLUTIONS OUTPUT
+ */
+int main(int argc, char *argv[]) {
+  if (argc != 4) {
+    std::cerr << "usage: " << argv[0] << " ALL_WORDS ALL_SOLUTIONS OUTPUT\n";
+    return EXIT_FAILURE;
+  }
+  const auto all_words = read_keys(argv[1]);
+  const auto all_solutions = read_keys(argv[2]);
+  if (all_words.empty() || all_solutions.empty()) {
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream out(argv[3], std::ios::trunc);
+  out << "// Generated by wordle-embed-word-lists from " << argv[1] << " and "
+      << argv[2] << "; do not edit.\n\n"
+      << "#ifndef WORDLE_SOLVER_EMBEDDED_WORD_LISTS_HPP_\n"
+      << "#define WORDLE_SOLVER_EMBEDDED_WORD_LISTS_HPP_\n\n"
+      << "#include <cstdint>\n\n"
+      << "/// PackedWord::key of every word, in file order\n"
+      << "namespace embedded_word_lists {\n\n";
+  write_array(out, "all_words", all_words);
+  write_array(out, "all_solutions", all_solutions);
+  out << "} // namespace embedded_word_lists\n\n"
+      << "#endif // WORDLE_SOLVER_EMBEDDED_WORD_LISTS_HPP_\n";
+  if (!out) {
+    std::cerr << "Failed to write file " << argv[3] << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,63 @@
+#include "dictionary.h"
+#include "opening_book.h"
+
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+namespace {
+
+/// stores `text` in `number` if all of it is a number of that type
+template <typename Number> bool parse_number(const char *text, Number *number) {
+  const auto *last = text + std::strlen(text);
+  Number parsed{};
+  const auto [end, error] = std::from_chars(text, last, parsed);
+  if (error != std::errc{} || end != last) {
+    return false;
+  }
+  *number = parsed;
+  return true;
+}
+
+} // namespace
+
+/**
+ * Usage: wordle-opening-book [--depth N] [--output FILE]
+ *
+ * --depth N      Turns to cover, 1 to 7; defaults to 2, the first two guesses
+ * --output FILE  Where to write the book; defaults to
+ *                word_lists/opening_book.bin
+ */
+int main(int argc, char *argv[]) {
+  int depth{2};
+  std::string output{"word_lists/opening_book.bin"};
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc &&
+        parse_number(argv[i + 1], &depth)) {
+      ++i;
+    } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+      output = argv[++i];
+    } else {
+      std::cerr << "usage: " << argv[0] << " [--depth N] [--output FILE]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  try {
+    const auto start = std::chrono::steady_clock::now();
+    const auto book = OpeningBook::build(Dictionary::shared_default(), depth);
+    book->save(output);
+    const auto duration = std::chrono::steady_clock::now() - start;
+    std::cout << "wrote " << book->size() << " guesses, " << depth
+              << " turns deep, to " << output << " in "
+              << std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+                     .count()
+              << " ms\n";
+  } catch (const std::exception &error) {
+    std::cerr << error.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,322 @@
+#include "dictionary.h"
+#include "feedback.h"
+#include "wordle_solver.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string socket_path{"/tmp/wordle-solver.sock"};
+  std::size_t connections{4};
+  std::size_t sessions{8}; ///< games played at once on each connection
+  std::size_t games{1000}; ///< games in total
+};
+
+/// what every connection adds to when it's done
+struct Totals {
+  std::mutex mutex;
+  std::vector<double> latencies_us;
+  std::size_t games{};
+  std::size_t guesses{};
+  std::size_t errors{};
+};
+
+/// a connection's game in progress
+struct Game {
+  enum class Step { create, guess, feedback, close, done };
+
+  std::string session;
+  std::string solution;
+  std::string last_guess;
+  std::size_t guesses{};
+  Step step{Step::create};
+};
+
+/// a connected socket to the daemon
+int connect_to(const std::string &path) {
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (fd < 0 || path.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("Cannot create a socket for " + path);
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+  if (::connect(fd, reinterpret_cast<const sockaddr *>(&address),
+                sizeof(address)) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Cannot connect to " + path + ": " +
+                             std::strerror(errno));
+  }
+  return fd;
+}
+
+/// a line-at-a-time reader over a socket
+class LineReader {
+ public:
+  explicit LineReader(int fd) : _fd{fd} {}
+
+  /// @throws std::runtime_error if the daemon hangs up
+  std::string next() {
+    for (;;) {
+      if (const auto end = _buffer.find('\n'); end != std::string::npos) {
+        auto line = _buffer.substr(0, end);
+        _buffer.erase(0, end + 1);
+        return line;
+      }
+      char chunk[4096];
+      const auto count = ::read(_fd, chunk, sizeof(chunk));
+      if (count <= 0) {
+        throw std::runtime_error("The daemon closed the connection");
+      }
+      _buffer.append(chunk, static_cast<std::size_t>(count));
+    }
+  }
+
+ private:
+  int _fd;
+  std::string _buffer;
+};
+
+void send_all(const int fd, const std::string &text) {
+  std::size_t sent{};
+  while (sent < text.size()) {
+    const auto count = ::send(fd, text.data() + sent, text.size() - sent,
+                              MSG_NOSIGNAL);
+    if (count <= 0) {
+      throw std::runtime_error("The daemon closed the connection");
+    }
+    sent += static_cast<std::size_t>(count);
+  }
+}
+
+/// the request for `game`'s next step
+std::string request_for(const Game &game) {
+  switch (game.step) {
+    case Game::Step::create:
+      return "new\n";
+    case Game::Step::guess:
+      return "guess " + game.session + '\n';
+    case Game::Step::feedback:
+      return "feedback " + game.session + ' ' +
+             Feedback::feedback_string(game.last_guess, game.solution) + '\n';
+    case Game::Step::close:
+      return "close " + game.session + '\n';
+    case Game::Step::done:
+      break;
+  }
+  return {};
+}
+
+/**
+ * Play games over one connection, Options::sessions at a time, sending one
+ * request for each game in progress before reading their replies
+ */
+void drive_connection(const Options &options,
+                      const std::vector<std::string> &solutions,
+                      std::atomic<std::size_t> *next_game, Totals *totals) {
+  const int fd = connect_to(options.socket_path);
+  LineReader reader{fd};
+  std::vector<double> latencies_us;
+  std::size_t games{};
+  std::size_t guesses{};
+  std::size_t errors{};
+
+  std::vector<Game> active;
+  const auto start_game = [&]() {
+    const auto k = next_game->fetch_add(1);
+    if (k >= options.games) {
+      return false;
+    }
+    Game game;
+    game.solution = solutions[k * 7919 % solutions.size()];
+    active.push_back(std::move(game));
+    return true;
+  };
+  while (active.size() < options.sessions && start_game()) {
+  }
+
+  while (!active.empty()) {
+    std::string batch;
+    for (const auto &game : active) {
+      batch += request_for(game);
+    }
+    const auto sent = Clock::now();
+    send_all(fd, batch);
+    for (auto &game : active) {
+      const auto reply = reader.next();
+      latencies_us.push_back(
+          std::chrono::duration<double, std::micro>(Clock::now() - sent)
+              .count());
+      if (reply.rfind("ok", 0) != 0) {
+        // give the game up; the session, if any, closes with the connection
+        ++errors;
+        game.step = Game::Step::done;
+        continue;
+      }
+      const auto value = reply.size() > 3 ? reply.substr(3) : std::string{};
+      switch (game.step) {
+        case Game::Step::create:
+          game.session = value;
+          game.step = Game::Step::guess;
+          break;
+        case Game::Step::guess:
+          game.last_guess = value;
+          ++game.guesses;
+          game.step = value == game.solution ? Game::Step::close
+                                             : Game::Step::feedback;
+          break;
+        case Game::Step::feedback:
+          game.step = Game::Step::guess;
+          break;
+        case Game::Step::close:
+          ++games;
+          guesses += game.guesses;
+          game.step = Game::Step::done;
+          break;
+        case Game::Step::done:
+          break;
+      }
+    }
+    active.erase(std::remove_if(active.begin(), active.end(),
+                                [](const Game &game) {
+                                  return game.step == Game::Step::done;
+                                }),
+                 active.end());
+    while (active.size() < options.sessions && start_game()) {
+    }
+  }
+  ::close(fd);
+
+  const std::lock_guard lock{totals->mutex};
+  totals->latencies_us.insert(totals->latencies_us.end(),
+                              latencies_us.begin(), latencies_us.end());
+  totals->games += games;
+  totals->guesses += guesses;
+  totals->errors += errors;
+}
+
+double percentile(const std::vector<double> &sorted, const double fraction) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  const auto index = static_cast<std::size_t>(
+      fraction * static_cast<double>(sorted.size() - 1));
+  return sorted[index];
+}
+
+/// stores `text` in `number` if all of it is a number of that type
+template <typename Number> bool parse_number(const char *text, Number *number) {
+  const auto *last = text + std::strlen(text);
+  Number parsed{};
+  const auto [end, error] = std::from_chars(text, last, parsed);
+  if (error != std::errc{} || end != last) {
+    return false;
+  }
+  *number = parsed;
+  return true;
+}
+
+} // namespace
+
+/**
+ * Usage: wordle-load [--socket PATH] [--connections C] [--sessions S]
+ *                    [--games G]
+ *
+ * Plays G games against a running wordle-daemon over C connections, each
+ * pipelining requests for S games at once, and reports the request rate and
+ * latency. A request's latency runs from sending its batch to reading its
+ * reply. Run from the directory holding word_lists/, or the lists compiled in
+ * are used.
+ */
+int main(int argc, char *argv[]) {
+  Options options;
+  for (int i = 1; i < argc; ++i) {
+    const bool has_value = i + 1 < argc;
+    if (std::strcmp(argv[i], "--socket") == 0 && has_value) {
+      options.socket_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--connections") == 0 && has_value &&
+               parse_number(argv[i + 1], &options.connections)) {
+      options.connections = std::max<std::size_t>(1, options.connections);
+      ++i;
+    } else if (std::strcmp(argv[i], "--sessions") == 0 && has_value &&
+               parse_number(argv[i + 1], &options.sessions)) {
+      options.sessions = std::max<std::size_t>(1, options.sessions);
+      ++i;
+    } else if (std::strcmp(argv[i], "--games") == 0 && has_value &&
+               parse_number(argv[i + 1], &options.games)) {
+      ++i;
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--socket PATH] [--connections C] [--sessions S]"
+                   " [--games G]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  const auto solutions =
+      std::filesystem::exists("word_lists/all_solutions.txt")
+          ? WordleSolver::load_wordlist("word_lists/all_solutions.txt")
+          : Dictionary::embedded()->all_solutions().to_strings();
+
+  std::atomic<std::size_t> next_game{};
+  Totals totals;
+  std::vector<std::string> failures;
+  std::mutex failures_mutex;
+  const auto start = Clock::now();
+  std::vector<std::thread> threads;
+  for (std::size_t c = 0; c < options.connections; ++c) {
+    threads.emplace_back([&]() {
+      try {
+        drive_connection(options, solutions, &next_game, &totals);
+      } catch (const std::runtime_error &error) {
+        const std::lock_guard lock{failures_mutex};
+        failures.emplace_back(error.what());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const auto seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+
+  for (const auto &failure : failures) {
+    std::cerr << failure << '\n';
+  }
+  auto &latencies = totals.latencies_us;
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "Requests: " << latencies.size() << " in " << seconds
+            << " s, " << static_cast<double>(latencies.size()) / seconds
+            << " per second\n";
+  std::cout << "Latency: p50 " << percentile(latencies, 0.5) << " us, p99 "
+            << percentile(latencies, 0.99) << " us, max "
+            << (latencies.empty() ? 0.0 : latencies.back()) << " us\n";
+  std::cout << std::setprecision(5);
+  std::cout << "Games: " << totals.games << ", average guesses "
+            << (totals.games == 0 ? 0.0
+                                  : static_cast<double>(totals.guesses) /
+                                        static_cast<double>(totals.games))
+            << ", errors " << totals.errors << '\n';
+  return failures.empty() && totals.errors == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,432 @@
+#include "server.h"
+
+#include "feedback.h"
+#include "thread_pool.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/// a request longer than this closes the connection
+constexpr std::size_t max_line{1024};
+/// so do more unread replies than this, from a client that doesn't read
+constexpr std::size_t max_output{std::size_t{1} << 20U};
+
+/// bytes on the wake pipe
+constexpr char wake_completion{'c'};
+constexpr char wake_stop{'s'};
+
+#if defined(MSG_NOSIGNAL)
+constexpr int send_flags{MSG_NOSIGNAL};
+#else
+constexpr int send_flags{0};
+#endif
+
+std::runtime_error system_error(const std::string &what) {
+  return std::runtime_error(what + ": " + std::strerror(errno));
+}
+
+void set_nonblocking(const int fd) {
+  const int flags = ::fcntl(fd, F_GETFL, 0);
+  if (flags < 0 || ::fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+    throw system_error("fcntl");
+  }
+}
+
+/// whether `feedback` is a pattern the game can give, e.g. "xygxx"
+bool valid_feedback(const std::string &feedback) {
+  return feedback.size() == static_cast<std::size_t>(WordleSolver::word_len) &&
+         std::all_of(feedback.begin(), feedback.end(), [](const char ch) {
+           return ch == 'x' || ch == 'y' || ch == 'g';
+         });
+}
+
+} // namespace
+
+Server::Server(std::shared_ptr<const Dictionary> dictionary,
+               std::shared_ptr<ThreadPool> pool,
+               std::shared_ptr<const OpeningBook> book,
+               std::shared_ptr<const DecisionTree> tree,
+               std::shared_ptr<FeedbackRows> rows)
+    : _dictionary{std::move(dictionary)}, _pool{std::move(pool)},
+      _book{std::move(book)}, _tree{std::move(tree)},
+      _rows{rows ? std::move(rows) : std::make_shared<FeedbackRows>()} {
+  int fds[2];
+  if (::pipe(fds) != 0) {
+    throw system_error("pipe");
+  }
+  _wake_read = fds[0];
+  _wake_write = fds[1];
+  set_nonblocking(_wake_read);
+  set_nonblocking(_wake_write);
+}
+
+Server::~Server() {
+  // the pool's tasks point at sessions and at this server
+  while (_running != 0) {
+    pollfd wake{_wake_read, POLLIN, 0};
+    ::poll(&wake, 1, 100);
+    char buffer[256];
+    while (::read(_wake_read, buffer, sizeof(buffer)) > 0) {
+    }
+    deliver_completions();
+  }
+  for (auto &[id, connection] : _connections) {
+    ::close(connection.fd);
+  }
+  if (_listener >= 0) {
+    ::close(_listener);
+    ::unlink(_socket_path.c_str());
+  }
+  ::close(_wake_read);
+  ::close(_wake_write);
+}
+
+void Server::listen(const std::string &socket_path) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  if (socket_path.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("socket path too long: " + socket_path);
+  }
+  std::strncpy(address.sun_path, socket_path.c_str(),
+               sizeof(address.sun_path) - 1);
+
+  _listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (_listener < 0) {
+    throw system_error("socket");
+  }
+  ::unlink(socket_path.c_str());
+  if (::bind(_listener, reinterpret_cast<const sockaddr *>(&address),
+             sizeof(address)) != 0) {
+    throw system_error("bind " + socket_path);
+  }
+  _socket_path = socket_path;
+  if (::listen(_listener, SOMAXCONN) != 0) {
+    throw system_error("listen");
+  }
+  set_nonblocking(_listener);
+}
+
+void Server::stop() {
+  _stopping = true;
+  const auto written = ::write(_wake_write, &wake_stop, 1);
+  static_cast<void>(written); // a full pipe wakes the loop just the same
+}
+
+void Server::run() {
+  std::vector<pollfd> fds;
+  std::vector<std::uint64_t> ids; // connection of fds[i + 2]
+  while (!_stopping) {
+    fds.clear();
+    ids.clear();
+    fds.push_back(pollfd{_wake_read, POLLIN, 0});
+    fds.push_back(pollfd{_listener, POLLIN, 0});
+    for (const auto &[id, connection] : _connections) {
+      const auto events = static_cast<short>(
+          connection.output.empty() ? POLLIN : POLLIN | POLLOUT);
+      fds.push_back(pollfd{connection.fd, events, 0});
+      ids.push_back(id);
+    }
+    if (::poll(fds.data(), fds.size(), -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw system_error("poll");
+    }
+
+    if (fds[0].revents != 0) {
+      char buffer[256];
+      ssize_t count{};
+      while ((count = ::read(_wake_read, buffer, sizeof(buffer))) > 0) {
+        if (std::find(buffer, buffer + count, wake_stop) != buffer + count) {
+          _stopping = true;
+        }
+      }
+      deliver_completions();
+    }
+    if (fds[1].revents != 0) {
+      accept_connections();
+    }
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      const auto events = fds[i + 2].revents;
+      // delivering a completion may have closed the connection
+      if ((events & (POLLIN | POLLHUP | POLLERR)) != 0 &&
+          _connections.count(ids[i]) != 0) {
+        read_from(ids[i]);
+      }
+      if ((events & POLLOUT) != 0 && _connections.count(ids[i]) != 0) {
+        write_to(ids[i]);
+      }
+    }
+  }
+}
+
+void Server::accept_connections() {
+  for (;;) {
+    const int fd = ::accept(_listener, nullptr, nullptr);
+    if (fd < 0) {
+      return; // EAGAIN once every pending connection is taken
+    }
+    set_nonblocking(fd);
+    auto &connection = _connections[_next_connection++];
+    connection.fd = fd;
+  }
+}
+
+void Server::read_from(const std::uint64_t id) {
+  char buffer[4096];
+  // a chunk at a time: a client that sends faster than it reads its replies
+  // then runs into max_output instead of piling up input
+  for (;;) {
+    const auto count =
+        ::recv(_connections.at(id).fd, buffer, sizeof(buffer), 0);
+    if (count > 0) {
+      _connections.at(id).input.append(buffer,
+                                       static_cast<std::size_t>(count));
+      handle_requests(id);
+      const auto found = _connections.find(id);
+      if (found == _connections.end()) {
+        return;
+      }
+      if (found->second.input.size() > max_line) {
+        close_connection(id);
+        return;
+      }
+      continue;
+    }
+    if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      return;
+    }
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    close_connection(id); // closed by the client, or failed
+    return;
+  }
+}
+
+void Server::write_to(const std::uint64_t id) {
+  auto &connection = _connections.at(id);
+  std::size_t written{};
+  while (written < connection.output.size()) {
+    const auto count =
+        ::send(connection.fd, connection.output.data() + written,
+               connection.output.size() - written, send_flags);
+    if (count > 0) {
+      written += static_cast<std::size_t>(count);
+      continue;
+    }
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    }
+    close_connection(id);
+    return;
+  }
+  connection.output.erase(0, written);
+}
+
+void Server::close_connection(const std::uint64_t id) {
+  auto found = _connections.find(id);
+  if (found == _connections.end()) {
+    return;
+  }
+  for (const auto session : found->second.sessions) {
+    auto &state = *_sessions.at(session);
+    if (state.guessing) {
+      state.closing = true;
+    } else {
+      _sessions.erase(session);
+    }
+  }
+  ::close(found->second.fd);
+  _connections.erase(found);
+}
+
+void Server::handle_requests(const std::uint64_t id) {
+  auto *connection = &_connections.at(id);
+  std::size_t start{};
+  for (auto end = connection->input.find('\n');
+       end != std::string::npos;
+       end = connection->input.find('\n', start)) {
+    std::istringstream words{connection->input.substr(start, end - start)};
+    start = end + 1;
+    std::string command;
+    std::string argument;
+    std::uint64_t session{};
+    words >> command;
+
+    const auto reply = connection->first_reply + connection->replies.size();
+    connection->replies.emplace_back();
+    if (command == "new") {
+      session = _next_session++;
+      auto state = std::make_unique<Session>(_dictionary);
+      state->solver.set_thread_count(1);
+      state->solver.set_opening_book(_book);
+      state->solver.set_decision_tree(_tree);
+      state->solver.set_guess_cache(_cache);
+      state->solver.set_feedback_rows(_rows);
+      state->connection = id;
+      _sessions.emplace(session, std::move(state));
+      connection->sessions.push_back(session);
+      set_reply(id, reply, "ok " + std::to_string(session));
+    } else if (!(words >> session) || _sessions.count(session) == 0 ||
+               _sessions.at(session)->connection != id) {
+      set_reply(id, reply,
+                command.empty() ? "error empty request"
+                                : "error unknown session");
+    } else {
+      words >> argument;
+      dispatch(id, session, command, argument, reply);
+    }
+    // replies may have closed it, if writing failed
+    if (_connections.count(id) == 0) {
+      return;
+    }
+    connection = &_connections.at(id);
+  }
+  connection->input.erase(0, start);
+}
+
+void Server::dispatch(const std::uint64_t connection,
+                      const std::uint64_t session, const std::string &command,
+                      const std::string &argument, const std::uint64_t reply) {
+  auto &state = *_sessions.at(session);
+  if (state.guessing) {
+    state.queued.push_back(Queued{command, argument, reply});
+    return;
+  }
+
+  if (command == "guess") {
+    if (state.solved) {
+      set_reply(connection, reply, "error already solved");
+    } else if (state.expecting_feedback) {
+      set_reply(connection, reply, "error feedback expected");
+    } else if (state.solver.remaining() == 0) {
+      set_reply(connection, reply, "error no word fits the feedback");
+    } else {
+      state.guessing = true;
+      ++_running;
+      _pool->submit([this, session, reply, solver = &state.solver] {
+        // a completion must come back either way, or the session waits on
+        // its guess for good
+        Completion completion{session, reply, {}, true};
+        try {
+          completion.text = "ok " + solver->guess();
+        } catch (const std::exception &error) {
+          completion.text = std::string{"error "} + error.what();
+          completion.guessed = false;
+        }
+        {
+          const std::lock_guard lock(_completions_mutex);
+          _completions.push_back(std::move(completion));
+        }
+        const auto written = ::write(_wake_write, &wake_completion, 1);
+        static_cast<void>(written); // a full pipe is read soon anyway
+      });
+    }
+  } else if (command == "feedback") {
+    if (!state.expecting_feedback) {
+      set_reply(connection, reply, "error guess first");
+    } else if (!valid_feedback(argument)) {
+      set_reply(connection, reply,
+                "error feedback is " +
+                    std::to_string(WordleSolver::word_len) +
+                    " of x, y and g");
+    } else {
+      state.expecting_feedback = false;
+      state.solved = Feedback::to_pattern(argument) ==
+                     Feedback::pattern_count - 1;
+      if (!state.solved) {
+        state.solver.accept_feedback(argument);
+      }
+      set_reply(connection, reply, "ok");
+    }
+  } else if (command == "close") {
+    erase_session(session);
+    set_reply(connection, reply, "ok");
+  } else {
+    set_reply(connection, reply, "error unknown command");
+  }
+}
+
+void Server::drain(const std::uint64_t session) {
+  for (;;) {
+    const auto found = _sessions.find(session);
+    if (found == _sessions.end() || found->second->guessing ||
+        found->second->queued.empty()) {
+      return;
+    }
+    const auto next = std::move(found->second->queued.front());
+    found->second->queued.pop_front();
+    dispatch(found->second->connection, session, next.command, next.argument,
+             next.reply);
+  }
+}
+
+void Server::deliver_completions() {
+  std::vector<Completion> completions;
+  {
+    const std::lock_guard lock(_completions_mutex);
+    completions.swap(_completions);
+  }
+  for (auto &completion : completions) {
+    --_running;
+    auto &state = *_sessions.at(completion.session);
+    state.guessing = false;
+    if (state.closing) {
+      _sessions.erase(completion.session); // its connection is gone
+      continue;
+    }
+    state.expecting_feedback = completion.guessed;
+    set_reply(state.connection, completion.reply, std::move(completion.text));
+    drain(completion.session);
+  }
+}
+
+void Server::set_reply(const std::uint64_t id, const std::uint64_t reply,
+                       std::string text) {
+  const auto found = _connections.find(id);
+  if (found == _connections.end()) {
+    return;
+  }
+  auto &connection = found->second;
+  auto &slot = connection.replies[reply - connection.first_reply];
+  slot.text = std::move(text);
+  slot.ready = true;
+  const bool was_empty = connection.output.empty();
+  while (!connection.replies.empty() && connection.replies.front().ready) {
+    connection.output += connection.replies.front().text;
+    connection.output += '\n';
+    connection.replies.pop_front();
+    ++connection.first_reply;
+  }
+  // write now rather than wait a turn of the loop; more replies from the
+  // same read are appended and go out with the next poll
+  if (was_empty && !connection.output.empty()) {
+    write_to(id);
+  }
+  const auto open = _connections.find(id);
+  if (open != _connections.end() && open->second.output.size() > max_output) {
+    close_connection(id);
+  }
+}
+
+void Server::erase_session(const std::uint64_t session) {
+  const auto found = _sessions.find(session);
+  auto &owned = _connections.at(found->second->connection).sessions;
+  owned.erase(std::remove(owned.begin(), owned.end(), session), owned.end());
+  _sessions.erase(found);
+}
@@ -0,0 +1,180 @@
+#ifndef WORDLE_SOLVER_DAEMON_SERVER_HPP_
+#define WORDLE_SOLVER_DAEMON_SERVER_HPP_
+
+#include "dictionary.h"
+#include "feedback_rows.h"
+#include "guess_cache.h"
+#include "wordle_solver.h"
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @class Server
+ * @brief Hosts solver sessions for clients on a Unix domain socket
+ * @details One thread runs an event loop over the listening socket and every
+ *          connection with poll(2), parsing requests and writing replies
+ *          without ever blocking. Guesses, which evaluate entropies, run on
+ *          a shared ThreadPool, one session per task; the loop hears of their
+ *          completion through a pipe. Every session plays with the same
+ *          Dictionary, so a session costs only its per-game state, and
+ *          looks its guesses up in one GuessCache, so games reaching the
+ *          same candidates are searched once.
+ *
+ *          The protocol is a line per request, answered by a line in
+ *          request order on each connection; sessions are multiplexed over
+ *          connections, so a client may pipeline requests for many games:
+ *
+ *          new                    -> ok <session>
+ *          guess <session>        -> ok <word>
+ *          feedback <session> <f> -> ok        (f as "xygxx")
+ *          close <session>        -> ok
+ *
+ *          Failures answer "error <reason>". A session belongs to the
+ *          connection that created it and is closed when the connection is.
+ *          A connection is closed if a request, or the replies its client
+ *          hasn't read, grow too long.
+ */
+class Server {
+ public:
+  /**
+   * @param dictionary Shared by every session
+   * @param pool Runs the guesses; each uses one of its threads
+   * @param book,tree Given to every session's solver, if set
+   * @param rows Shared by every session when the dictionary has no pattern
+   *        table; nullptr makes rows of the default budget
+   */
+  Server(std::shared_ptr<const Dictionary> dictionary,
+         std::shared_ptr<ThreadPool> pool,
+         std::shared_ptr<const OpeningBook> book,
+         std::shared_ptr<const DecisionTree> tree,
+         std::shared_ptr<FeedbackRows> rows = nullptr);
+  ~Server();
+
+  Server(const Server &) = delete;
+  Server &operator=(const Server &) = delete;
+  Server(Server &&) = delete;
+  Server &operator=(Server &&) = delete;
+
+  /**
+   * @brief Listen on `socket_path`, replacing any socket file there
+   * @throws std::runtime_error if the socket can't be set up
+   */
+  void listen(const std::string &socket_path);
+
+  /// serve until Server::stop is called
+  void run();
+
+  /// make Server::run return; safe from any thread and from signal handlers
+  void stop();
+
+  /// sessions open now
+  [[nodiscard]] auto session_count() const -> std::size_t {
+    return _sessions.size();
+  }
+
+ private:
+  struct Reply {
+    std::string text;
+    bool ready{};
+  };
+
+  struct Connection {
+    int fd{-1};
+    std::string input;
+    std::string output;
+    /// replies in request order, the pending ones still being computed
+    std::deque<Reply> replies;
+    /// Connection::replies.front()'s number, counting from the first reply
+    std::uint64_t first_reply{};
+    std::vector<std::uint64_t> sessions;
+  };
+
+  /// a request waiting for its session to finish a guess
+  struct Queued {
+    std::string command;
+    std::string argument;
+    std::uint64_t reply{}; ///< its number in the connection's replies
+  };
+
+  struct Session {
+    explicit Session(std::shared_ptr<const Dictionary> dictionary)
+        : solver{std::move(dictionary)} {}
+
+    WordleSolver solver;
+    std::uint64_t connection{};
+    bool guessing{};           ///< a guess is running on the pool
+    bool expecting_feedback{}; ///< the last request was a guess
+    bool solved{};
+    bool closing{}; ///< close once the running guess is done
+    std::deque<Queued> queued;
+  };
+
+  /// a guess computed on the pool, for the loop to deliver
+  struct Completion {
+    std::uint64_t session{};
+    std::uint64_t reply{};
+    std::string text;
+    bool guessed{}; ///< false if the guess failed and `text` is an error
+  };
+
+  void accept_connections();
+  void read_from(std::uint64_t id);
+  void write_to(std::uint64_t id);
+  void close_connection(std::uint64_t id);
+
+  /// answer every complete line in the connection's input
+  void handle_requests(std::uint64_t id);
+
+  /// run `command` for `session`, or queue it behind a running guess
+  void dispatch(std::uint64_t connection, std::uint64_t session,
+                const std::string &command, const std::string &argument,
+                std::uint64_t reply);
+
+  /// run the requests queued while the session's guess ran
+  void drain(std::uint64_t session);
+
+  void deliver_completions();
+
+  /**
+   * @brief Fill in reply number `reply` of connection `id`
+   * @note  Closes the connection if its unread replies grow too long
+   */
+  void set_reply(std::uint64_t id, std::uint64_t reply, std::string text);
+
+  void erase_session(std::uint64_t session);
+
+  std::shared_ptr<const Dictionary> _dictionary;
+  std::shared_ptr<ThreadPool> _pool;
+  std::shared_ptr<const OpeningBook> _book;
+  std::shared_ptr<const DecisionTree> _tree;
+  std::shared_ptr<GuessCache> _cache{std::make_shared<GuessCache>()};
+  std::shared_ptr<FeedbackRows> _rows;
+
+  int _listener{-1};
+  std::string _socket_path;
+  /// written to by Server::stop and by the pool when a guess is done
+  int _wake_read{-1};
+  int _wake_write{-1};
+  std::atomic<bool> _stopping{};
+
+  std::unordered_map<std::uint64_t, Connection> _connections;
+  std::unordered_map<std::uint64_t, std::unique_ptr<Session>> _sessions;
+  std::uint64_t _next_connection{1};
+  std::uint64_t _next_session{1};
+
+  std::mutex _completions_mutex;
+  std::vector<Completion> _completions;
+  /// guesses running on the pool, which ~Server waits for
+  std::size_t _running{};
+};
+
+#endif // WORDLE_SOLVER_DAEMON_SERVER_HPP_
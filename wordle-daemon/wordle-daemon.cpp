@@ -0,0 +1,163 @@
+#include "server.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <charconv>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+/// the server for the signal handler to stop
+Server *running_server{};
+
+extern "C" void handle_signal(int /*signal*/) {
+  if (running_server != nullptr) {
+    running_server->stop();
+  }
+}
+
+/**
+ * The mapped binary dictionary if there is one, otherwise the word lists, or
+ * failing those, the lists compiled into the program, which build their
+ * table whatever the `storage`
+ */
+std::shared_ptr<const Dictionary>
+open_dictionary(const Dictionary::Storage storage) {
+  const auto stored = [storage](std::shared_ptr<const Dictionary> dictionary)
+      -> std::shared_ptr<const Dictionary> {
+    if (storage == Dictionary::Storage::table) {
+      return dictionary;
+    }
+    // the words of a mapped file stay where they are, and the table's pages
+    // are never read
+    return std::make_shared<const Dictionary>(
+        dictionary->all_words(), dictionary->all_solutions(), storage);
+  };
+  if (const std::string file{"word_lists/dictionary.bin"};
+      std::filesystem::exists(file)) {
+    try {
+      return stored(Dictionary::map(file));
+    } catch (const std::runtime_error &error) {
+      std::cerr << "Ignoring binary dictionary: " << error.what() << '\n';
+    }
+  }
+  if (std::filesystem::exists("word_lists/all_words.txt") &&
+      std::filesystem::exists("word_lists/all_solutions.txt")) {
+    return storage == Dictionary::Storage::table
+               ? Dictionary::shared_default()
+               : Dictionary::load("word_lists/all_words.txt",
+                                  "word_lists/all_solutions.txt", storage);
+  }
+  return stored(Dictionary::embedded());
+}
+
+/// `load(file)` if the file exists and loads, otherwise nullptr
+template <typename T, typename Load>
+std::shared_ptr<const T> load_optional(const std::string &file,
+                                       const char *what, Load load) {
+  if (!std::filesystem::exists(file)) {
+    return nullptr;
+  }
+  try {
+    return load(file);
+  } catch (const std::runtime_error &error) {
+    std::cerr << "Ignoring " << what << ": " << error.what() << '\n';
+    return nullptr;
+  }
+}
+
+/// stores `text` in `number` if all of it is a number of that type
+template <typename Number> bool parse_number(const char *text, Number *number) {
+  const auto *last = text + std::strlen(text);
+  Number parsed{};
+  const auto [end, error] = std::from_chars(text, last, parsed);
+  if (error != std::errc{} || end != last) {
+    return false;
+  }
+  *number = parsed;
+  return true;
+}
+
+} // namespace
+
+/**
+ * Usage: wordle-daemon [--socket PATH] [--threads N]
+ *                      [--feedback-budget BYTES]
+ *
+ * --socket PATH            Where to listen; defaults to /tmp/wordle-solver.sock
+ * --threads N              Threads computing guesses; defaults to one per core
+ * --feedback-budget BYTES  Play without a pattern table, for small machines,
+ *                          computing feedback on demand into at most BYTES
+ *                          of rows shared by the sessions
+ *
+ * Serves games until interrupted; see Server for the protocol.
+ */
+int main(int argc, char *argv[]) {
+  std::string socket_path{"/tmp/wordle-solver.sock"};
+  unsigned thread_count{std::max(1U, std::thread::hardware_concurrency())};
+  std::optional<std::size_t> feedback_budget;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--socket") == 0 && i + 1 < argc) {
+      socket_path = argv[++i];
+    } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc &&
+               parse_number(argv[i + 1], &thread_count)) {
+      thread_count = std::max(1U, thread_count);
+      ++i;
+    } else if (std::size_t budget{};
+               std::strcmp(argv[i], "--feedback-budget") == 0 &&
+               i + 1 < argc && parse_number(argv[i + 1], &budget)) {
+      feedback_budget = budget;
+      ++i;
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--socket PATH] [--threads N]"
+                   " [--feedback-budget BYTES]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  const auto dictionary = open_dictionary(
+      feedback_budget ? Dictionary::Storage::on_demand
+                      : Dictionary::Storage::table);
+  const auto rows = feedback_budget
+                        ? std::make_shared<FeedbackRows>(*feedback_budget)
+                        : nullptr;
+  // built by the opening_book and decision_tree targets, as for the CLI
+  const auto book = load_optional<OpeningBook>(
+      "word_lists/opening_book.bin", "opening book",
+      [&dictionary](const std::string &file) {
+        return OpeningBook::load(file, *dictionary);
+      });
+  const auto tree = load_optional<DecisionTree>(
+      "word_lists/decision_tree.bin", "decision tree",
+      [&dictionary](const std::string &file) {
+        return DecisionTree::load(file, *dictionary);
+      });
+
+  // the event loop isn't one of the pool's threads, so every thread counted
+  // by the pool is a worker
+  const auto pool = std::make_shared<ThreadPool>(thread_count + 1);
+  try {
+    Server server{dictionary, pool, book, tree, rows};
+    server.listen(socket_path);
+    running_server = &server;
+    std::signal(SIGINT, handle_signal);
+    std::signal(SIGTERM, handle_signal);
+    std::signal(SIGPIPE, SIG_IGN);
+    std::cout << "Serving on " << socket_path << " with " << thread_count
+              << " threads" << std::endl;
+    server.run();
+    running_server = nullptr;
+  } catch (const std::runtime_error &error) {
+    std::cerr << error.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return 0;
+}
@@ -1,13 +1,206 @@
+#include "decision_tree.h"
+#include "dictionary.h"
+#include "multi_board_solver.h"
 #include "wordle_solver.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
 
-int main() {
-  WordleSolver ws;
+/**
+ * The mapped binary dictionary if there is one, otherwise the word lists, or
+ * failing those, the lists compiled into the program
+ */
+std::shared_ptr<const Dictionary> open_dictionary() {
+  if (const std::string file{"word_lists/dictionary.bin"};
+      std::filesystem::exists(file)) {
+    try {
+      return Dictionary::map(file);
+    } catch (const std::runtime_error &error) {
+      std::cerr << "Ignoring binary dictionary: " << error.what() << '\n';
+    }
+  }
+  if (std::filesystem::exists("word_lists/all_words.txt") &&
+      std::filesystem::exists("word_lists/all_solutions.txt")) {
+    return Dictionary::shared_default();
+  }
+  return Dictionary::embedded();
+}
+
+/**
+ * Six rounds of guessing, reading the feedback to each guess from std::cin,
+ * until the feedback is all green; with a `trace_file`, the turns are
+ * written to it as Chrome trace events
+ */
+template <typename Solver>
+void play(Solver *ws, const std::string &trace_file) {
+  ws->set_tracing(!trace_file.empty());
   for (int i = 0; i < 6; ++i) {
-    std::cout << ws.guess() << ' ';
+    std::cout << ws->guess() << ' ';
     std::string line;
     std::getline(std::cin, line);
-    ws.accept_feedback(line);
+    if (line == std::string(Solver::word_len, 'g')) {
+      break; // solved
+    }
+    ws->accept_feedback(line);
+  }
+  if (!trace_file.empty()) {
+    std::ofstream out(trace_file);
+    write_chrome_trace(out, ws->trace());
+  }
+}
+
+/**
+ * A game of `boards` boards at once, guessing until all are solved or the
+ * guesses run out: 9 for Quordle's 4 boards, 13 for Octordle's 8. The
+ * feedback to a guess is one line with a string per board
+ */
+template <int N>
+void play_boards(std::shared_ptr<const BasicDictionary<N>> dictionary,
+                 const std::size_t boards) {
+  BasicMultiBoardSolver<N> ms{std::move(dictionary), boards};
+  for (std::size_t i = 0; i < boards + 5 && !ms.all_solved(); ++i) {
+    std::cout << ms.guess() << ' ';
+    for (;;) {
+      std::string line;
+      if (!std::getline(std::cin, line)) {
+        return;
+      }
+      std::istringstream words{line};
+      const std::vector<std::string> feedback{
+          std::istream_iterator<std::string>{words}, {}};
+      if (feedback.size() == boards) {
+        ms.accept_feedback(feedback);
+        break;
+      }
+      std::cerr << "Expected " << boards << " feedback strings\n";
+    }
+  }
+}
+
+/**
+ * A game of `N`-letter words from "word_lists/all_words_N.txt" and
+ * "word_lists/all_solutions_N.txt". Only five-letter lists come with the
+ * solver, so these are the user's own
+ * @return The exit status: failure if the lists are missing or malformed
+ */
+template <int N>
+int play_length(const std::size_t boards, const std::string &trace_file) {
+  const auto suffix = '_' + std::to_string(N) + ".txt";
+  for (const auto &file : {"word_lists/all_words" + suffix,
+                           "word_lists/all_solutions" + suffix}) {
+    if (!std::filesystem::exists(file)) {
+      std::cerr << "--length " << N << " needs lists of " << N
+                << "-letter words, which don't come with the solver: put "
+                   "the guesses in word_lists/all_words"
+                << suffix << " and the solutions in word_lists/all_solutions"
+                << suffix << ", one word per line (" << file
+                << " is missing)\n";
+      return EXIT_FAILURE;
+    }
+  }
+  try {
+    if (boards > 1) {
+      play_boards<N>(BasicDictionary<N>::shared_default(), boards);
+      return EXIT_SUCCESS;
+    }
+    BasicWordleSolver<N> ws;
+    play(&ws, trace_file);
+  } catch (const std::invalid_argument &error) {
+    std::cerr << "Bad " << N << "-letter word list: " << error.what() << '\n';
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+/// stores `text` in `number` if all of it is a number of that type
+template <typename Number> bool parse_number(const char *text, Number *number) {
+  const auto *last = text + std::strlen(text);
+  Number parsed{};
+  const auto [end, error] = std::from_chars(text, last, parsed);
+  if (error != std::errc{} || end != last) {
+    return false;
+  }
+  *number = parsed;
+  return true;
+}
+
+} // namespace
+
+/**
+ * Usage: wordle-solver [--length N] [--boards B] [--trace FILE]
+ *
+ * --length N    Play with words of 4 to 8 letters; defaults to 5. Lengths
+ *               other than 5 need word_lists/all_words_N.txt and
+ *               word_lists/all_solutions_N.txt, which aren't included
+ * --boards B    Solve B words at once, as in Quordle (4) or Octordle (8)
+ * --trace FILE  Write where each turn's time went as Chrome trace events,
+ *               for chrome://tracing or Perfetto; one board only
+ */
+int main(int argc, char *argv[]) {
+  int length{WordleSolver::word_len};
+  std::size_t boards{1};
+  std::string trace_file;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--length") == 0 && i + 1 < argc &&
+        parse_number(argv[i + 1], &length)) {
+      ++i;
+    } else if (std::strcmp(argv[i], "--boards") == 0 && i + 1 < argc &&
+               parse_number(argv[i + 1], &boards)) {
+      boards = std::max<std::size_t>(1, boards);
+      ++i;
+    } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+      trace_file = argv[++i];
+    } else {
+      std::cerr << "usage: " << argv[0]
+                << " [--length N] [--boards B] [--trace FILE]\n";
+      return EXIT_FAILURE;
+    }
+  }
+  switch (length) {
+  case 4: return play_length<4>(boards, trace_file);
+  case 5: break;
+  case 6: return play_length<6>(boards, trace_file);
+  case 7: return play_length<7>(boards, trace_file);
+  case 8: return play_length<8>(boards, trace_file);
+  default:
+    std::cerr << "word length must be 4 to 8\n";
+    return EXIT_FAILURE;
+  }
+
+  if (boards > 1) {
+    play_boards<5>(open_dictionary(), boards);
+    return 0;
+  }
+  const auto dictionary = open_dictionary();
+  WordleSolver ws{dictionary};
+  // built by the opening_book target; the solver works without it
+  if (const std::string book{"word_lists/opening_book.bin"};
+      std::filesystem::exists(book)) {
+    try {
+      ws.set_opening_book(OpeningBook::load(book, *dictionary));
+    } catch (const std::runtime_error &error) {
+      std::cerr << "Ignoring opening book: " << error.what() << '\n';
+    }
+  }
+  // built by the decision_tree target; plays ahead of the book when present
+  if (const std::string tree{"word_lists/decision_tree.bin"};
+      std::filesystem::exists(tree)) {
+    try {
+      ws.set_decision_tree(DecisionTree::load(tree, *dictionary));
+    } catch (const std::runtime_error &error) {
+      std::cerr << "Ignoring decision tree: " << error.what() << '\n';
+    }
   }
+  play(&ws, trace_file);
   return 0;
 }